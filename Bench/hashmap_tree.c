@@ -0,0 +1,103 @@
+/*
+ * gHashMap against the tree containers for keyed lookups.
+ *
+ * usage: hashmap_tree [entries] [lookups]
+ *
+ * Keys are random 64 bit integers, half of the lookups miss. gAVL is only
+ * measured up to AVL_LIMIT entries: gAVLAdd recomputes subtree heights on
+ * every rebalance, which makes filling it more than quadratic. gBST filled in random
+ * order has the same O(log n) pointer chasing lookups and is measured at
+ * every size.
+ */
+#include <generic/hashmap.h>
+#include <generic/avl.h>
+#include <generic/bst.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#define AVL_LIMIT 16384
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int u64_greater(void *a, void *b) {
+    return *(uint64_t *) a > *(uint64_t *) b;
+}
+
+static void report(const char *name, size_t n, double insert, double lookup, size_t lookups) {
+    printf("%-10s %10zu entries  insert %8.1f ns  lookup %8.1f ns\n",
+           name, n, insert * 1e9 / n, lookup * 1e9 / lookups);
+}
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+    size_t q = argc > 2 ? strtoul(argv[2], NULL, 10) : 10000000;
+
+    uint64_t *keys = malloc(n * sizeof(uint64_t));
+    uint64_t *queries = malloc(q * sizeof(uint64_t));
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = next_random();
+    }
+    for (size_t i = 0; i < q; ++i) {
+        queries[i] = (i & 1) ? next_random() : keys[next_random() % n];
+    }
+
+    size_t hits = 0;
+    double start = now();
+    gHashMap *map = gHashMapCreate(sizeof(uint64_t), sizeof(uint64_t), NULL, NULL);
+    for (size_t i = 0; i < n; ++i) {
+        gHashMapPut(map, &keys[i], &keys[i]);
+    }
+    double insert = now() - start;
+    start = now();
+    for (size_t i = 0; i < q; ++i) {
+        hits += gHashMapGet(map, &queries[i]) != NULL;
+    }
+    report("gHashMap", n, insert, now() - start, q);
+    gHashMapDelete(map);
+
+    start = now();
+    gBST *bst = gBSTCreate(sizeof(uint64_t), u64_greater);
+    for (size_t i = 0; i < n; ++i) {
+        gBSTAdd(bst, &keys[i]);
+    }
+    insert = now() - start;
+    start = now();
+    for (size_t i = 0; i < q; ++i) {
+        hits += gBSTSearch(bst, &queries[i]) != NULL;
+    }
+    report("gBST", n, insert, now() - start, q);
+    gBSTDelete(bst);
+
+    size_t avl_n = n < AVL_LIMIT ? n : AVL_LIMIT;
+    start = now();
+    gAVL *avl = gAVLCreate(sizeof(uint64_t), u64_greater);
+    for (size_t i = 0; i < avl_n; ++i) {
+        gAVLAdd(avl, &keys[i]);
+    }
+    insert = now() - start;
+    start = now();
+    for (size_t i = 0; i < q; ++i) {
+        hits += gAVLSearch(avl, &queries[i]) != NULL;
+    }
+    report("gAVL", avl_n, insert, now() - start, q);
+    gAVLDelete(avl);
+
+    printf("hits=%zu\n", hits);
+    free(queries);
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * The generic sorts against the C library qsort.
+ *
+ * usage: sort [elements]
+ *
+ * Sorts random 32 bit integers and random 24 byte records keyed on an
+ * integer, through a comparison function like any user of the library,
+ * then 64 bit timestamps with the radix sort as well. gParallel is
+ * gParallelMergeSort with one thread per online processor. The "nearly"
+ * rows are sorted integers with one element in a thousand replaced.
+ */
+#include <generic/algorithm.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+struct record {
+    uint64_t key;
+    uint64_t payload[2];
+};
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int compare_int(void *a, void *b) {
+    int x = *(int *) a, y = *(int *) b;
+    return (x > y) - (x < y);
+}
+
+static int compare_int_qsort(const void *a, const void *b) {
+    return compare_int((void *) a, (void *) b);
+}
+
+static int compare_u64(void *a, void *b) {
+    uint64_t x = *(uint64_t *) a, y = *(uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+static int compare_u64_qsort(const void *a, const void *b) {
+    return compare_u64((void *) a, (void *) b);
+}
+
+static int compare_record(void *a, void *b) {
+    uint64_t x = ((struct record *) a)->key, y = ((struct record *) b)->key;
+    return (x > y) - (x < y);
+}
+
+static int compare_record_qsort(const void *a, const void *b) {
+    return compare_record((void *) a, (void *) b);
+}
+
+static void run(const char *name, void *data, void *work, size_t n, size_t elem_sz,
+                cmpfunc_t cmp, int (*qcmp)(const void *, const void *)) {
+    const char *names[] = {"gSort", "gMergeSort", "qsort", "gParallel", "gTimSort"};
+    int which;
+    for (which = 0; which < 5; which++) {
+        memcpy(work, data, n * elem_sz);
+        double start = now();
+        if (which == 0) {
+            gSort(work, n, elem_sz, cmp);
+        } else if (which == 1) {
+            gMergeSort(work, n, elem_sz, cmp);
+        } else if (which == 2) {
+            qsort(work, n, elem_sz, qcmp);
+        } else if (which == 3) {
+            gParallelMergeSort(work, n, elem_sz, cmp, 0);
+        } else {
+            gTimSort(work, n, elem_sz, cmp);
+        }
+        double elapsed = now() - start;
+        printf("%-8s %-10s %10zu elements  %8.1f ns/element\n", name, names[which], n, elapsed * 1e9 / n);
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+    int *ints = malloc(n * sizeof(int));
+    struct record *records = malloc(n * sizeof(struct record));
+    void *work = malloc(n * sizeof(struct record));
+    for (size_t i = 0; i < n; ++i) {
+        ints[i] = (int) next_random();
+        records[i].key = next_random();
+    }
+    run("int", ints, work, n, sizeof(int), compare_int, compare_int_qsort);
+    run("record", records, work, n, sizeof(struct record), compare_record, compare_record_qsort);
+    for (size_t i = 0; i < n; ++i) {
+        ints[i] = next_random() % 1000 ? (int) i : (int) (next_random() % n);
+    }
+    run("nearly", ints, work, n, sizeof(int), compare_int, compare_int_qsort);
+
+    // Timestamps in microseconds over a day
+    uint64_t *stamps = (uint64_t *) records;
+    for (size_t i = 0; i < n; ++i) {
+        stamps[i] = 1700000000000000ull + next_random() % 86400000000ull;
+    }
+    run("u64", stamps, work, n, sizeof(uint64_t), compare_u64, compare_u64_qsort);
+    memcpy(work, stamps, n * sizeof(uint64_t));
+    double start = now();
+    gRadixSortU64(work, n);
+    printf("%-8s %-10s %10zu elements  %8.1f ns/element\n", "u64", "gRadixSort", n, (now() - start) * 1e9 / n);
+    free(work);
+    free(records);
+    free(ints);
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * Splay tree against a plain BST on Zipf distributed lookups.
+ *
+ * usage: splay_zipf [keys] [queries] [exponent]
+ *
+ * One BST is filled in random order, the other in median order so it is
+ * perfectly balanced, the static best case without any access pattern.
+ * The splay tree gets the keys in the same order as the random BST.
+ */
+#include <generic/splay.h>
+#include <generic/bst.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void shuffle(int *arr, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        arr[i] = (int) i;
+    }
+    for (size_t i = n - 1; i > 0; --i) {
+        size_t j = next_random() % (i + 1);
+        int tmp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = tmp;
+    }
+}
+
+/* Add lo..hi-1 to the tree, each subrange's median first */
+static void addBalanced(gBST *bst, int lo, int hi) {
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        gBSTAdd(bst, &mid);
+        addBalanced(bst, lo, mid);
+        lo = mid + 1;
+    }
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+    size_t q = argc > 2 ? strtoul(argv[2], NULL, 10) : 10000000;
+    double s = argc > 3 ? atof(argv[3]) : 1.0;
+
+    // Keys are inserted in the order of keys[], rank r of the distribution
+    // is looked up as ranks[r]. Two independent shuffles, so the hot keys
+    // are not the ones inserted first and sitting near the root of the BST.
+    int *keys = malloc(n * sizeof(int));
+    int *ranks = malloc(n * sizeof(int));
+    shuffle(keys, n);
+    shuffle(ranks, n);
+
+    // Zipf cumulative distribution, sampled by binary search
+    double *cdf = malloc(n * sizeof(double));
+    double sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += 1.0 / pow((double) (i + 1), s);
+        cdf[i] = sum;
+    }
+    int *queries = malloc(q * sizeof(int));
+    for (size_t i = 0; i < q; ++i) {
+        double u = (next_random() >> 11) * (1.0 / 9007199254740992.0) * sum;
+        size_t lo = 0, hi = n - 1;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1; else hi = mid;
+        }
+        queries[i] = ranks[lo];
+    }
+
+    gBST *bst = gBSTCreate(sizeof(int), gINT_COMPARE);
+    gSplay *splay = gSplayCreate(sizeof(int), gINT_COMPARE);
+    for (size_t i = 0; i < n; ++i) {
+        gBSTAdd(bst, &keys[i]);
+        gSplayAdd(splay, &keys[i]);
+    }
+    gBST *balanced = gBSTCreate(sizeof(int), gINT_COMPARE);
+    addBalanced(balanced, 0, (int) n);
+
+    size_t hits = 0;
+    double start = now();
+    for (size_t i = 0; i < q; ++i) {
+        hits += gBSTSearch(bst, &queries[i]) != NULL;
+    }
+    double bst_time = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < q; ++i) {
+        hits += gBSTSearch(balanced, &queries[i]) != NULL;
+    }
+    double balanced_time = now() - start;
+
+    start = now();
+    for (size_t i = 0; i < q; ++i) {
+        hits += gSplaySearch(splay, &queries[i]) != NULL;
+    }
+    double splay_time = now() - start;
+
+    printf("keys=%zu queries=%zu s=%.2f hits=%zu\n", n, q, s, hits);
+    printf("gBSTSearch   %8.1f ns/lookup (random order)\n", bst_time * 1e9 / q);
+    printf("gBSTSearch   %8.1f ns/lookup (balanced)\n", balanced_time * 1e9 / q);
+    printf("gSplaySearch %8.1f ns/lookup\n", splay_time * 1e9 / q);
+
+    gBSTDelete(bst);
+    gBSTDelete(balanced);
+    gSplayDelete(splay);
+    free(queries);
+    free(cdf);
+    free(ranks);
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <generic/algorithm.h>
+
+#define N 1000
+
+int compare_int(void *a,void *b)
+{
+	int x=*(int*)a,y=*(int*)b;
+	return (x>y)-(x<y);
+}
+
+int main(void)
+{
+	int ints[N];
+	int32_t i32[N];
+	int64_t i64[N];
+	uint64_t u64[N];
+	size_t n,i,lo,hi,first,last;
+	int key;
+	srand(42);
+	for(n=0;n<=N;n+=n<40?1:97){
+		// Sorted with runs of duplicates and negative values
+		for(i=0;i<n;i++){
+			ints[i]=rand()%(int)(n/2+1)-(int)(n/4);
+		}
+		gSort(ints,n,sizeof(int),compare_int);
+		for(i=0;i<n;i++){
+			i32[i]=ints[i];
+			i64[i]=(int64_t)ints[i]*4000000000LL;
+			u64[i]=(uint64_t)(ints[i]+(int)N);
+		}
+		for(key=-(int)(n/4)-2;key<=(int)(n/4)+2;key++){
+			for(lo=0;lo<n&&ints[lo]<key;lo++);
+			for(hi=lo;hi<n&&ints[hi]==key;hi++);
+			gEqualRange(&key,ints,n,sizeof(int),compare_int,&first,&last);
+			if(gLowerBound(&key,ints,n,sizeof(int),compare_int)!=lo
+			   ||gUpperBound(&key,ints,n,sizeof(int),compare_int)!=hi
+			   ||first!=lo||last!=hi
+			   ||gBinarySearch(&key,ints,n,sizeof(int),compare_int)!=(lo<hi?ints+lo:NULL)){
+				fprintf(stderr,"n=%zu key=%d: generic search wrong\n",n,key);
+				return 1;
+			}
+			if(gLowerBoundI32(i32,n,key)!=lo||gUpperBoundI32(i32,n,key)!=hi
+			   ||gLowerBoundI64(i64,n,key*4000000000LL)!=lo
+			   ||gUpperBoundI64(i64,n,key*4000000000LL)!=hi
+			   ||gLowerBoundU64(u64,n,(uint64_t)(key+(int)N))!=lo
+			   ||gUpperBoundU64(u64,n,(uint64_t)(key+(int)N))!=hi){
+				fprintf(stderr,"n=%zu key=%d: typed search wrong\n",n,key);
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <generic/algorithm.h>
+
+#define N 100003
+
+struct record{
+	uint32_t key;
+	uint32_t order;
+};
+
+int compare_record(void *a,void *b)
+{
+	uint32_t x=((struct record*)a)->key,y=((struct record*)b)->key;
+	return (x>y)-(x<y);
+}
+
+static int sort_file(size_t n,size_t budget,uint32_t mod)
+{
+	FILE *in=tmpfile(),*out=tmpfile();
+	struct record r,prev;
+	size_t i;
+	for(i=0;i<n;i++){
+		r.key=(uint32_t)rand()%mod;
+		r.order=(uint32_t)i;
+		fwrite(&r,sizeof(r),1,in);
+	}
+	fflush(in);
+	rewind(in);
+	if(gExternalSort(fileno(in),fileno(out),sizeof(struct record),compare_record,budget,NULL)!=0){
+		fprintf(stderr,"%zu records, budget %zu: gExternalSort failed\n",n,budget);
+		return 1;
+	}
+	rewind(out);
+	for(i=0;fread(&r,sizeof(r),1,out)==1;i++){
+		if(i>0&&(prev.key>r.key||(prev.key==r.key&&prev.order>r.order))){
+			fprintf(stderr,"%zu records, budget %zu: not sorted stably at %zu\n",n,budget,i);
+			return 1;
+		}
+		prev=r;
+	}
+	if(i!=n){
+		fprintf(stderr,"%zu records, budget %zu: %zu written\n",n,budget,i);
+		return 1;
+	}
+	fclose(in);
+	fclose(out);
+	return 0;
+}
+
+int main(void)
+{
+	srand(42);
+	// In memory, a single merge of 6 runs, and several passes of two way merges
+	if(sort_file(N,N*sizeof(struct record)*2,1000)
+	   ||sort_file(1000000,2<<20,100000)
+	   ||sort_file(N,16<<10,1000)
+	   ||sort_file(N,64,100)
+	   ||sort_file(0,64,1)
+	   ||sort_file(1,64,1)){
+		return 1;
+	}
+	// A partial record is refused
+	FILE *in=tmpfile(),*out=tmpfile();
+	fwrite("abc",1,3,in);
+	rewind(in);
+	if(gExternalSort(fileno(in),fileno(out),sizeof(struct record),compare_record,1<<20,NULL)!=G_EINVAL
+	   ||gExternalSort(fileno(in),fileno(out),sizeof(struct record),compare_record,8,NULL)!=G_EINVAL){
+		fprintf(stderr,"invalid input accepted\n");
+		return 1;
+	}
+	fclose(in);
+	fclose(out);
+	return 0;
+}
@@ -0,0 +1,86 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <generic/algorithm.h>
+
+#define MAX_K 300
+
+struct record{
+	int key;
+	int order;
+};
+
+static size_t comparisons;
+
+int compare_record(void *a,void *b)
+{
+	comparisons++;
+	return ((struct record*)a)->key-((struct record*)b)->key;
+}
+
+static int merge(size_t k,size_t max_len)
+{
+	static struct record *inputs[MAX_K];
+	static size_t counts[MAX_K];
+	struct record *all,*out;
+	size_t i,j,total=0,log_k=0;
+	gVector vec;
+	for(i=0;i<k;i++){
+		counts[i]=(size_t)rand()%(max_len+1);
+		inputs[i]=malloc((counts[i]+1)*sizeof(struct record));
+		for(j=0;j<counts[i];j++){
+			inputs[i][j].key=rand()%50;
+			inputs[i][j].order=(int)(total+j);
+		}
+		gMergeSort(inputs[i],counts[i],sizeof(struct record),compare_record);
+		total+=counts[i];
+	}
+	// Stable sorting the concatenation gives the expected output
+	all=malloc((total+1)*sizeof(struct record));
+	out=malloc((total+1)*sizeof(struct record));
+	for(i=0,j=0;i<k;j+=counts[i],i++){
+		memcpy(all+j,inputs[i],counts[i]*sizeof(struct record));
+	}
+	gMergeSort(all,total,sizeof(struct record),compare_record);
+	while((1u<<log_k)<k){
+		log_k++;
+	}
+	comparisons=0;
+	if(gMergeK((void*const*)inputs,counts,k,sizeof(struct record),compare_record,out)!=out
+	   ||memcmp(out,all,total*sizeof(struct record))!=0){
+		fprintf(stderr,"k=%zu: wrong merge\n",k);
+		return 1;
+	}
+	if(comparisons>total*log_k+k){
+		fprintf(stderr,"k=%zu: %zu comparisons for %zu elements\n",k,comparisons,total);
+		return 1;
+	}
+	// Appending to a vector keeps what it holds
+	gVectorCreate(&vec,sizeof(struct record));
+	gVectorResize(&vec,1);
+	((struct record*)gVectorFront(&vec))->key=-1;
+	if(gMergeKVector((void*const*)inputs,counts,k,compare_record,&vec)!=0
+	   ||vec.n!=total+1
+	   ||((struct record*)gVectorFront(&vec))->key!=-1
+	   ||memcmp(gVectorItemAt(&vec,1),all,total*sizeof(struct record))!=0){
+		fprintf(stderr,"k=%zu: wrong merge into vector\n",k);
+		return 1;
+	}
+	gVectorDestroy(&vec);
+	for(i=0;i<k;i++){
+		free(inputs[i]);
+	}
+	free(all);
+	free(out);
+	return 0;
+}
+
+int main(void)
+{
+	srand(42);
+	if(merge(0,0)||merge(1,100)||merge(2,1000)||merge(7,1000)
+	   ||merge(64,500)||merge(65,3)||merge(MAX_K,200)){
+		return 1;
+	}
+	return 0;
+}
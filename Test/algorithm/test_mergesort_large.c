@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <generic/algorithm.h>
+
+#define N 1000003
+
+struct record{
+	int key;
+	int order;
+};
+
+int compare_record(void *a,void *b)
+{
+	return ((struct record*)a)->key-((struct record*)b)->key;
+}
+
+int main(void)
+{
+	struct record *records=malloc(N*sizeof(struct record));
+	int *ints=malloc(N*sizeof(int));
+	size_t i,n;
+	srand(42);
+	// Few distinct keys, so stability matters
+	for(i=0;i<N;i++){
+		records[i].key=rand()%100;
+		records[i].order=(int)i;
+		ints[i]=rand()-RAND_MAX/2;
+	}
+	if(gMergeSort(records,N,sizeof(struct record),compare_record)!=records){
+		fprintf(stderr,"gMergeSort failed\n");
+		return 1;
+	}
+	for(i=1;i<N;i++){
+		if(records[i-1].key>records[i].key
+		   ||(records[i-1].key==records[i].key&&records[i-1].order>records[i].order)){
+			fprintf(stderr,"records not sorted stably at %zu\n",i);
+			return 1;
+		}
+	}
+	mergeSort(ints,N);
+	// Sorting again takes the already ordered path
+	mergeSort(ints,N);
+	for(i=1;i<N;i++){
+		if(ints[i-1]>ints[i]){
+			fprintf(stderr,"ints not sorted at %zu\n",i);
+			return 1;
+		}
+	}
+	// Short arrays, including the sizes around a run
+	for(n=0;n<40;n++){
+		for(i=0;i<n;i++){
+			ints[i]=(int)(n-i);
+			records[i].key=(int)(n-i);
+		}
+		mergeSort(ints,n);
+		gMergeSort(records,n,sizeof(struct record),compare_record);
+		for(i=1;i<n;i++){
+			if(ints[i-1]>ints[i]||records[i-1].key>records[i].key){
+				fprintf(stderr,"%zu elements not sorted\n",n);
+				return 1;
+			}
+		}
+	}
+	printf("Sorted %d records and %d integers\n",N,N);
+	free(ints);
+	free(records);
+	return 0;
+}
@@ -0,0 +1,54 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <generic/algorithm.h>
+
+#define N 1000003
+
+struct record{
+	int key;
+	int order;
+};
+
+int compare_record(void *a,void *b)
+{
+	return ((struct record*)a)->key-((struct record*)b)->key;
+}
+
+int main(void)
+{
+	struct record *input=malloc(N*sizeof(struct record));
+	struct record *expected=malloc(N*sizeof(struct record));
+	struct record *records=malloc(N*sizeof(struct record));
+	unsigned int threads[]={0,2,3,4,7,64};
+	size_t i,t;
+	srand(11);
+	for(i=0;i<N;i++){
+		input[i].key=rand()%1000;
+		input[i].order=(int)i;
+	}
+	memcpy(expected,input,N*sizeof(struct record));
+	gMergeSort(expected,N,sizeof(struct record),compare_record);
+	for(t=0;t<sizeof(threads)/sizeof(threads[0]);t++){
+		memcpy(records,input,N*sizeof(struct record));
+		if(gParallelMergeSort(records,N,sizeof(struct record),compare_record,threads[t])!=records
+		   ||memcmp(records,expected,N*sizeof(struct record))!=0){
+			fprintf(stderr,"%u threads: result differs from gMergeSort\n",threads[t]);
+			return 1;
+		}
+	}
+	// Below the cutoff, sorted by the sequential sort
+	memcpy(records,input,1000*sizeof(struct record));
+	gParallelMergeSort(records,1000,sizeof(struct record),compare_record,8);
+	for(i=1;i<1000;i++){
+		if(records[i-1].key>records[i].key){
+			fprintf(stderr,"small array not sorted\n");
+			return 1;
+		}
+	}
+	printf("Parallel sorts match gMergeSort\n");
+	free(records);
+	free(expected);
+	free(input);
+	return 0;
+}
@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <generic/algorithm.h>
+
+#define N 200000
+
+struct wide{
+	int key;
+	char pad[300];
+};
+
+int compare_int(void *a,void *b)
+{
+	int x=*(int*)a,y=*(int*)b;
+	return (x>y)-(x<y);
+}
+
+int compare_int_qsort(const void *a,const void *b)
+{
+	return compare_int((void*)a,(void*)b);
+}
+
+/* Three byte elements, compared on their first byte */
+int compare_first_byte(void *a,void *b)
+{
+	return *(unsigned char*)a-*(unsigned char*)b;
+}
+
+int compare_wide(void *a,void *b)
+{
+	return compare_int(&((struct wide*)a)->key,&((struct wide*)b)->key);
+}
+
+static int check_ints(const char *pattern,int *arr,int *expected,size_t n)
+{
+	memcpy(expected,arr,n*sizeof(int));
+	qsort(expected,n,sizeof(int),compare_int_qsort);
+	gSort(arr,n,sizeof(int),compare_int);
+	if(memcmp(arr,expected,n*sizeof(int))!=0){
+		fprintf(stderr,"%s: %zu elements not sorted\n",pattern,n);
+		return 1;
+	}
+	return 0;
+}
+
+int main(void)
+{
+	int *arr=malloc(N*sizeof(int));
+	int *expected=malloc(N*sizeof(int));
+	size_t i,n;
+	int failed=0;
+	srand(7);
+	for(n=0;n<=100;n++){
+		for(i=0;i<n;i++){
+			arr[i]=rand()%10;
+		}
+		failed|=check_ints("small",arr,expected,n);
+	}
+	for(i=0;i<N;i++)arr[i]=rand();
+	failed|=check_ints("random",arr,expected,N);
+	failed|=check_ints("sorted",arr,expected,N);
+	for(i=0;i<N;i++)arr[i]=(int)(N-i);
+	failed|=check_ints("reversed",arr,expected,N);
+	for(i=0;i<N;i++)arr[i]=5;
+	failed|=check_ints("equal",arr,expected,N);
+	for(i=0;i<N;i++)arr[i]=(int)(i<N/2?i:N-i);
+	failed|=check_ints("organ pipe",arr,expected,N);
+	for(i=0;i<N;i++)arr[i]=rand()%4;
+	failed|=check_ints("few distinct",arr,expected,N);
+	for(i=0;i<N;i++)arr[i]=(int)(i%1000==0?(size_t)rand():i);
+	failed|=check_ints("nearly sorted",arr,expected,N);
+
+	unsigned char *bytes=malloc(3*N);
+	for(i=0;i<3*N;i++)bytes[i]=(unsigned char)rand();
+	gSort(bytes,N,3,compare_first_byte);
+	for(i=1;i<N;i++){
+		if(bytes[3*(i-1)]>bytes[3*i]){
+			fprintf(stderr,"3 byte elements not sorted at %zu\n",i);
+			failed=1;
+			break;
+		}
+	}
+
+	struct wide *wide=malloc(1000*sizeof(struct wide));
+	for(i=0;i<1000;i++)wide[i].key=rand()%100;
+	gSort(wide,1000,sizeof(struct wide),compare_wide);
+	for(i=1;i<1000;i++){
+		if(wide[i-1].key>wide[i].key){
+			fprintf(stderr,"wide elements not sorted at %zu\n",i);
+			failed=1;
+			break;
+		}
+	}
+	if(!failed){
+		printf("All patterns sorted\n");
+	}
+	free(wide);
+	free(bytes);
+	free(expected);
+	free(arr);
+	return failed;
+}
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <generic/algorithm.h>
+
+#define N 300000
+
+struct event{
+	int32_t id;
+	int16_t priority;
+	uint64_t time;
+};
+
+static uint64_t state=0x9e3779b97f4a7c15ull;
+
+static uint64_t next_random(void)
+{
+	state^=state<<13;
+	state^=state>>7;
+	state^=state<<17;
+	return state;
+}
+
+#define DEFINE_COMPARE(name,type) \
+	static int name(const void *a,const void *b) \
+	{ \
+		type x=*(const type*)a,y=*(const type*)b; \
+		return (x>y)-(x<y); \
+	}
+
+DEFINE_COMPARE(compare_u32,uint32_t)
+DEFINE_COMPARE(compare_i32,int32_t)
+DEFINE_COMPARE(compare_u64,uint64_t)
+DEFINE_COMPARE(compare_i64,int64_t)
+DEFINE_COMPARE(compare_double,double)
+
+int main(void)
+{
+	void *arr=malloc(N*sizeof(uint64_t));
+	void *expected=malloc(N*sizeof(uint64_t));
+	size_t i;
+	int failed=0;
+
+#define CHECK(type,sort,compare,fill) \
+	for(i=0;i<N;i++){ \
+		((type*)arr)[i]=(fill); \
+	} \
+	memcpy(expected,arr,N*sizeof(type)); \
+	qsort(expected,N,sizeof(type),compare); \
+	if(sort((type*)arr,N)!=arr||memcmp(arr,expected,N*sizeof(type))!=0){ \
+		fprintf(stderr,#sort " failed\n"); \
+		failed=1; \
+	}
+
+	CHECK(uint32_t,gRadixSortU32,compare_u32,(uint32_t)next_random())
+	CHECK(int32_t,gRadixSortI32,compare_i32,(int32_t)next_random())
+	CHECK(uint64_t,gRadixSortU64,compare_u64,next_random())
+	CHECK(int64_t,gRadixSortI64,compare_i64,(int64_t)next_random())
+	// Timestamps only differ in their low bytes, most passes are skipped
+	CHECK(uint64_t,gRadixSortU64,compare_u64,UINT64_C(1700000000000)+next_random()%100000)
+	CHECK(double,gRadixSortDouble,compare_double,((double)(int64_t)next_random())/1e6)
+
+	float floats[]={3.5f,-0.0f,INFINITY,-2.0f,0.0f,-INFINITY,1e-30f,-1e30f,2.0f,-1e-30f};
+	float sorted[]={-INFINITY,-1e30f,-2.0f,-1e-30f,-0.0f,0.0f,1e-30f,2.0f,3.5f,INFINITY};
+	gRadixSortFloat(floats,10);
+	if(memcmp(floats,sorted,sizeof(floats))!=0){
+		fprintf(stderr,"gRadixSortFloat failed\n");
+		failed=1;
+	}
+
+	// Records on a signed 16 bit key, equal keys keep their order
+	struct event *events=malloc(N*sizeof(struct event));
+	for(i=0;i<N;i++){
+		events[i].id=(int32_t)i;
+		events[i].priority=(int16_t)(next_random()%200-100);
+	}
+	gRadixSortRecords(events,N,sizeof(struct event),offsetof(struct event,priority),sizeof(int16_t),G_RADIX_SIGNED);
+	for(i=1;i<N;i++){
+		if(events[i-1].priority>events[i].priority
+		   ||(events[i-1].priority==events[i].priority&&events[i-1].id>events[i].id)){
+			fprintf(stderr,"gRadixSortRecords not stable at %zu\n",i);
+			failed=1;
+			break;
+		}
+	}
+	if(gRadixSortRecords(events,N,sizeof(struct event),offsetof(struct event,time),3,0)!=NULL
+	   ||gErrorCode!=G_EINVAL){
+		fprintf(stderr,"3 byte key accepted\n");
+		failed=1;
+	}
+	if(!failed){
+		printf("All radix sorts passed\n");
+	}
+	free(events);
+	free(expected);
+	free(arr);
+	return failed;
+}
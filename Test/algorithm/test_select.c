@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <generic/algorithm.h>
+
+#define N 5000
+
+int compare_int(void *a,void *b)
+{
+	int x=*(int*)a,y=*(int*)b;
+	return (x>y)-(x<y);
+}
+
+static void fill(int *arr,size_t n,int pattern)
+{
+	size_t i;
+	for(i=0;i<n;i++){
+		switch(pattern){
+		case 0:
+			arr[i]=rand();
+			break;
+		case 1:
+			arr[i]=rand()%4;
+			break;
+		case 2:
+			arr[i]=(int)i;
+			break;
+		case 3:
+			arr[i]=(int)(n-i);
+			break;
+		default:
+			// Organ pipe
+			arr[i]=(int)(i<n/2?i:n-i);
+		}
+	}
+}
+
+int main(void)
+{
+	static int arr[N],sorted[N],out[N];
+	size_t n,k,i;
+	int pattern;
+	gTopK *top;
+	srand(42);
+	for(pattern=0;pattern<5;pattern++){
+		for(n=1;n<=N;n=n<40?n+1:n*3){
+			for(k=0;k<n;k+=n<40?1:n/7+1){
+				fill(arr,n,pattern);
+				memcpy(out,arr,n*sizeof(int));
+				memcpy(sorted,arr,n*sizeof(int));
+				gSort(sorted,n,sizeof(int),compare_int);
+				gNthElement(arr,n,sizeof(int),compare_int,k);
+				if(arr[k]!=sorted[k]){
+					fprintf(stderr,"pattern %d n=%zu: wrong element %zu\n",pattern,n,k);
+					return 1;
+				}
+				for(i=0;i<n;i++){
+					if((i<k&&arr[i]>arr[k])||(i>k&&arr[i]<arr[k])){
+						fprintf(stderr,"pattern %d n=%zu: not partitioned at %zu\n",pattern,n,k);
+						return 1;
+					}
+				}
+				memcpy(arr,out,n*sizeof(int));
+				gPartialSort(arr,n,sizeof(int),compare_int,k);
+				if(memcmp(arr,sorted,k*sizeof(int))!=0){
+					fprintf(stderr,"pattern %d n=%zu: first %zu not sorted\n",pattern,n,k);
+					return 1;
+				}
+			}
+		}
+	}
+	// Top 100 fed in uneven batches
+	fill(arr,N,0);
+	memcpy(sorted,arr,N*sizeof(int));
+	gSort(sorted,N,sizeof(int),compare_int);
+	top=gTopKCreate(sizeof(int),100,compare_int);
+	for(i=0;i<N;i+=k){
+		k=(size_t)rand()%300;
+		gTopKAddBatch(top,arr+i,i+k<N?k:N-i);
+		if(i==0&&gTopKResult(top,out)!=(k<100?k:100)){
+			fprintf(stderr,"wrong count of a partial top-k\n");
+			return 1;
+		}
+	}
+	if(gTopKResult(top,out)!=100){
+		fprintf(stderr,"wrong top-k count\n");
+		return 1;
+	}
+	for(i=0;i<100;i++){
+		if(out[i]!=sorted[N-1-i]){
+			fprintf(stderr,"wrong top-k at %zu\n",i);
+			return 1;
+		}
+	}
+	gTopKDelete(top);
+	return 0;
+}
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <generic/algorithm.h>
+
+#define N 200003
+
+struct record{
+	int key;
+	int order;
+};
+
+static size_t comparisons;
+
+int compare_record(void *a,void *b)
+{
+	comparisons++;
+	return ((struct record*)a)->key-((struct record*)b)->key;
+}
+
+static int check(struct record *r,size_t n,const char *what)
+{
+	size_t i;
+	for(i=1;i<n;i++){
+		if(r[i-1].key>r[i].key
+		   ||(r[i-1].key==r[i].key&&r[i-1].order>r[i].order)){
+			fprintf(stderr,"%s: not sorted stably at %zu of %zu\n",what,i,n);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static int sort_and_check(struct record *r,size_t n,const char *what)
+{
+	size_t i;
+	for(i=0;i<n;i++){
+		r[i].order=(int)i;
+	}
+	if(gTimSort(r,n,sizeof(struct record),compare_record)!=r){
+		fprintf(stderr,"%s: gTimSort failed\n",what);
+		return 1;
+	}
+	return check(r,n,what);
+}
+
+int main(void)
+{
+	struct record *r=malloc(N*sizeof(struct record));
+	size_t i,n;
+	srand(42);
+	// Few distinct keys, so stability matters
+	for(i=0;i<N;i++){
+		r[i].key=rand()%100;
+	}
+	if(sort_and_check(r,N,"random")){
+		return 1;
+	}
+	// Presorted input is a single run
+	comparisons=0;
+	if(sort_and_check(r,N,"sorted")){
+		return 1;
+	}
+	if(comparisons!=N-1){
+		fprintf(stderr,"sorted: %zu comparisons\n",comparisons);
+		return 1;
+	}
+	// Strictly descending input is reversed
+	for(i=0;i<N;i++){
+		r[i].key=(int)(N-i);
+	}
+	comparisons=0;
+	if(sort_and_check(r,N,"descending")||comparisons!=N-1){
+		return 1;
+	}
+	// Sorted with a few elements out of place, galloping does the work
+	for(i=0;i<N;i++){
+		r[i].key=(int)i;
+	}
+	for(i=0;i<50;i++){
+		r[rand()%N].key=rand()%N;
+	}
+	comparisons=0;
+	if(sort_and_check(r,N,"nearly sorted")){
+		return 1;
+	}
+	if(comparisons>N*4){
+		fprintf(stderr,"nearly sorted: %zu comparisons\n",comparisons);
+		return 1;
+	}
+	// Sawtooth of ascending runs of varied lengths
+	for(i=0;i<N;i++){
+		r[i].key=(int)(i%(1000+i/1000));
+	}
+	if(sort_and_check(r,N,"runs")){
+		return 1;
+	}
+	for(i=0;i<N;i++){
+		r[i].key=7;
+	}
+	if(sort_and_check(r,N,"equal")){
+		return 1;
+	}
+	// Short arrays, around the binary insertion cutoff
+	for(n=0;n<100;n++){
+		for(i=0;i<n;i++){
+			r[i].key=rand()%8;
+		}
+		if(sort_and_check(r,n,"short")){
+			return 1;
+		}
+	}
+	free(r);
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include <generic/bloom.h>
+#include <generic/bst.h>
+#include <generic/avl.h>
+#include <stdio.h>
+
+#define N_KEYS 100000
+
+long long keys[N_KEYS];
+long long absent[N_KEYS];
+unsigned char results[N_KEYS];
+
+int main(void) {
+    for (long long i = 0; i < N_KEYS; ++i) {
+        keys[i] = i * 2;
+        absent[i] = i * 2 + 1;
+    }
+    gBloom *bloom = gBloomCreate(sizeof(long long), N_KEYS, 0.01);
+    gBloomAddBatch(bloom, keys, N_KEYS / 2);
+    for (int i = N_KEYS / 2; i < N_KEYS; ++i) {
+        gBloomAdd(bloom, &keys[i]);
+    }
+    if (gBloomContainsBatch(bloom, keys, N_KEYS, results) != N_KEYS) {
+        fprintf(stderr, "false negative\n");
+        return 1;
+    }
+    size_t false_positives = gBloomContainsBatch(bloom, absent, N_KEYS, results);
+    for (int i = 0; i < N_KEYS; ++i) {
+        if (results[i] != gBloomContains(bloom, &absent[i])) {
+            fprintf(stderr, "%lld: batch and single query differ\n", absent[i]);
+            return 1;
+        }
+    }
+    double rate = (double) false_positives / N_KEYS;
+    if (rate > 0.015) {
+        fprintf(stderr, "false positive rate %.4f\n", rate);
+        return 1;
+    }
+
+    size_t size = gBloomSerialize(bloom, NULL, 0);
+    void *buf = malloc(size);
+    gBloomSerialize(bloom, buf, size);
+    gBloom *copy = gBloomDeserialize(buf, size);
+    if (copy == NULL || copy->count != N_KEYS
+        || gBloomContainsBatch(copy, absent, N_KEYS, results) != false_positives) {
+        fprintf(stderr, "deserialized filter differs\n");
+        return 1;
+    }
+    if (gBloomDeserialize(buf, size - 1) != NULL) {
+        fprintf(stderr, "truncated filter accepted\n");
+        return 1;
+    }
+    free(buf);
+    gBloomDelete(copy);
+    gBloomDelete(bloom);
+
+    // Filter in front of a tree, items added before and after attaching
+    gBST *bst = gBSTCreate(sizeof(long long), gINT_COMPARE);
+    gAVL *avl = gAVLCreate(sizeof(long long), gINT_COMPARE);
+    gBloom *filter = gBloomCreate(sizeof(long long), 1000, 0.01);
+    gBloom *avlFilter = gBloomCreate(sizeof(long long), 1000, 0.01);
+    for (int i = 0; i < 1000; ++i) {
+        gBSTAdd(bst, &keys[(i * 7919) % 1000]);
+        gAVLAdd(avl, &keys[(i * 7919) % 1000]);
+        if (i == 500) {
+            gBSTAttachFilter(bst, filter);
+            gAVLAttachFilter(avl, avlFilter);
+        }
+    }
+    for (int i = 0; i < 1000; ++i) {
+        if (gBSTSearch(bst, &keys[i]) == NULL || gAVLSearch(avl, &keys[i]) == NULL) {
+            fprintf(stderr, "%lld: not found through the filter\n", keys[i]);
+            return 1;
+        }
+        if (gBSTSearch(bst, &absent[i]) != NULL || gAVLSearch(avl, &absent[i]) != NULL) {
+            fprintf(stderr, "%lld: found but never added\n", absent[i]);
+            return 1;
+        }
+    }
+    printf("False positive rate %.4f, %zu bytes serialized\n", rate, size);
+    gBSTDelete(bst);
+    gAVLDelete(avl);
+    gBloomDelete(filter);
+    gBloomDelete(avlFilter);
+    return 0;
+}
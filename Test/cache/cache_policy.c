@@ -0,0 +1,85 @@
+#include <generic/cache.h>
+#include <stdio.h>
+
+#define N_OPS 100000
+#define N_KEYS 1000
+
+static int evicted;
+
+static void onEvict(void *key, void *value, void *ctx) {
+    (void) value;
+    evicted = *(int *) key;
+    (*(int *) ctx)++;
+}
+
+/* 1, 2 and 3 cached, 1 used again, 4 must push out 2 */
+static int checkOrder(int policy) {
+    int count = 0;
+    gCache *cache = gCacheCreate(sizeof(int), sizeof(int), 3, policy, NULL, NULL);
+    gCacheSetEvict(cache, onEvict, &count);
+    for (int key = 1; key <= 3; ++key) {
+        int value = key * 10;
+        gCachePut(cache, &key, &value);
+    }
+    int key = 1;
+    if (gCacheGet(cache, &key) == NULL || *(int *) gCacheGet(cache, &key) != 10) {
+        fprintf(stderr, "policy %d: 1 not cached\n", policy);
+        return 1;
+    }
+    key = 4;
+    gCachePut(cache, &key, &key);
+    if (count != 1 || evicted != 2) {
+        fprintf(stderr, "policy %d: evicted %d\n", policy, evicted);
+        return 1;
+    }
+    key = 2;
+    if (gCacheGet(cache, &key) != NULL || gCacheRemove(cache, &key) != G_ENOITM) {
+        fprintf(stderr, "policy %d: 2 still cached\n", policy);
+        return 1;
+    }
+    gCacheDelete(cache);
+    return 0;
+}
+
+/* Random puts, gets and removes against a plain array */
+static int checkRandom(int policy) {
+    static int stored[N_KEYS];
+    int count = 0;
+    for (int i = 0; i < N_KEYS; ++i) {
+        stored[i] = -1;
+    }
+    gCache *cache = gCacheCreate(sizeof(int), sizeof(int), 100, policy, NULL, NULL);
+    gCacheSetEvict(cache, onEvict, &count);
+    unsigned int state = 12345;
+    for (int i = 0; i < N_OPS; ++i) {
+        state = state * 1103515245 + 12345;
+        int key = (state >> 8) % N_KEYS;
+        int op = (state >> 24) % 4;
+        int value = i;
+        if (op == 0) {
+            gCacheRemove(cache, &key);
+            stored[key] = -1;
+        } else if (op == 1) {
+            gCachePut(cache, &key, &value);
+            stored[key] = value;
+        } else {
+            int *found = gCacheGet(cache, &key);
+            if (found != NULL && *found != stored[key]) {
+                fprintf(stderr, "policy %d: %d maps to %d instead of %d\n", policy, key, *found, stored[key]);
+                return 1;
+            }
+        }
+        if (cache->size > cache->capacity || cache->size != cache->index->size) {
+            fprintf(stderr, "policy %d: size %zu\n", policy, cache->size);
+            return 1;
+        }
+    }
+    printf("policy %d: %zu hits, %zu misses, %d evictions\n", policy, cache->hits, cache->misses, count);
+    gCacheDelete(cache);
+    return 0;
+}
+
+int main(void) {
+    return checkOrder(G_CACHE_LRU) || checkOrder(G_CACHE_CLOCK)
+           || checkRandom(G_CACHE_LRU) || checkRandom(G_CACHE_CLOCK);
+}
@@ -0,0 +1,110 @@
+#include <generic/concurrentmap.h>
+#include <pthread.h>
+#include <stdio.h>
+
+#define N_WRITERS   4
+#define N_READERS   2
+#define N_KEYS      20000
+#define N_COUNTERS  100
+#define N_INCREMENTS 1000
+
+gConcurrentMap *map;
+int writers_done = 0;
+int torn_reads = 0;
+int computed = 0;
+
+void increment(void *value, int exists, void *ctx) {
+    long long *counter = (long long *) value;
+    (void) ctx;
+    *counter = exists ? *counter + 1 : 1;
+}
+
+int compute(void *key, void *value, void *ctx) {
+    (void) ctx;
+    __atomic_fetch_add(&computed, 1, __ATOMIC_RELAXED);
+    *(long long *) value = *(long long *) key * 2;
+    return 0;
+}
+
+void *writer(void *arg) {
+    long long base = (long long) (size_t) arg * 1000000;
+    for (long long i = 0; i < N_KEYS; ++i) {
+        long long key = base + i, value = key * 2;
+        gConcurrentMapPut(map, &key, &value);
+        if (i % 2 == 1) {
+            key--;
+            gConcurrentMapRemove(map, &key);
+        }
+    }
+    for (int round = 0; round < N_INCREMENTS; ++round) {
+        for (long long key = -N_COUNTERS; key < 0; ++key) {
+            gConcurrentMapUpsert(map, &key, increment, NULL);
+        }
+    }
+    for (long long key = 1 << 30; key < (1 << 30) + 1000; ++key) {
+        long long value;
+        if (gConcurrentMapComputeIfAbsent(map, &key, compute, NULL, &value) != 0 || value != key * 2) {
+            __atomic_fetch_add(&torn_reads, 1, __ATOMIC_RELAXED);
+        }
+    }
+    return NULL;
+}
+
+void *reader(void *arg) {
+    unsigned int seed = (unsigned int) (size_t) arg;
+    while (!__atomic_load_n(&writers_done, __ATOMIC_ACQUIRE)) {
+        long long key = (long long) (rand_r(&seed) % N_WRITERS) * 1000000 + rand_r(&seed) % N_KEYS;
+        long long value;
+        if (gConcurrentMapGet(map, &key, &value) && value != key * 2) {
+            __atomic_fetch_add(&torn_reads, 1, __ATOMIC_RELAXED);
+        }
+    }
+    return NULL;
+}
+
+int main(void) {
+    pthread_t writers[N_WRITERS], readers[N_READERS];
+    map = gConcurrentMapCreate(sizeof(long long), sizeof(long long), 8, NULL, NULL);
+    for (size_t i = 0; i < N_READERS; ++i) {
+        pthread_create(&readers[i], NULL, reader, (void *) (i + 1));
+    }
+    for (size_t i = 0; i < N_WRITERS; ++i) {
+        pthread_create(&writers[i], NULL, writer, (void *) i);
+    }
+    for (size_t i = 0; i < N_WRITERS; ++i) {
+        pthread_join(writers[i], NULL);
+    }
+    __atomic_store_n(&writers_done, 1, __ATOMIC_RELEASE);
+    for (size_t i = 0; i < N_READERS; ++i) {
+        pthread_join(readers[i], NULL);
+    }
+
+    if (torn_reads != 0) {
+        fprintf(stderr, "%d inconsistent values read\n", torn_reads);
+        return 1;
+    }
+    for (long long key = -N_COUNTERS; key < 0; ++key) {
+        long long value = 0;
+        if (!gConcurrentMapGet(map, &key, &value) || value != N_WRITERS * N_INCREMENTS) {
+            fprintf(stderr, "counter %lld is %lld\n", key, value);
+            return 1;
+        }
+    }
+    if (computed != 1000) {
+        fprintf(stderr, "compute called %d times for 1000 keys\n", computed);
+        return 1;
+    }
+    size_t expected = N_WRITERS * N_KEYS / 2 + N_COUNTERS + 1000;
+    if (gConcurrentMapSize(map) != expected) {
+        fprintf(stderr, "size %zu, expected %zu\n", gConcurrentMapSize(map), expected);
+        return 1;
+    }
+    if (gConcurrentMapCreate(sizeof(int), 0, SIZE_MAX, NULL, NULL) != NULL || gConcurrentMapSize(NULL) != 0) {
+        fprintf(stderr, "too many shards or NULL map accepted\n");
+        return 1;
+    }
+    printf("%zu entries over %zu shards\n", gConcurrentMapSize(map), map->nshards);
+
+    gConcurrentMapDelete(map);
+    return 0;
+}
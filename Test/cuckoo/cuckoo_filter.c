@@ -0,0 +1,70 @@
+#include <generic/cuckoo.h>
+#include <stdio.h>
+
+#define N_KEYS 100000
+
+long long keys[N_KEYS];
+long long absent[N_KEYS];
+
+static int check(unsigned int bits, double maxRate) {
+    gCuckoo *filter = gCuckooCreate(sizeof(long long), N_KEYS, bits);
+    for (int i = 0; i < N_KEYS; ++i) {
+        if (gCuckooAdd(filter, &keys[i]) != 0) {
+            fprintf(stderr, "%u bits: filter full after %d keys\n", bits, i);
+            return 1;
+        }
+    }
+    for (int i = 0; i < N_KEYS; ++i) {
+        if (!gCuckooContains(filter, &keys[i])) {
+            fprintf(stderr, "%u bits: false negative\n", bits);
+            return 1;
+        }
+    }
+    size_t false_positives = 0;
+    for (int i = 0; i < N_KEYS; ++i) {
+        false_positives += gCuckooContains(filter, &absent[i]);
+    }
+    double rate = (double) false_positives / N_KEYS;
+    if (rate > maxRate) {
+        fprintf(stderr, "%u bits: false positive rate %.4f\n", bits, rate);
+        return 1;
+    }
+    // Remove the even half, the odd half must stay
+    for (int i = 0; i < N_KEYS; i += 2) {
+        if (gCuckooRemove(filter, &keys[i]) != 0) {
+            fprintf(stderr, "%u bits: %lld not removed\n", bits, keys[i]);
+            return 1;
+        }
+    }
+    for (int i = 1; i < N_KEYS; i += 2) {
+        if (!gCuckooContains(filter, &keys[i])) {
+            fprintf(stderr, "%u bits: false negative after removal\n", bits);
+            return 1;
+        }
+    }
+    if (filter->count != N_KEYS / 2) {
+        fprintf(stderr, "%u bits: count %zu\n", bits, filter->count);
+        return 1;
+    }
+    // Keep adding until the filter reports it is full
+    long long next = 2 * N_KEYS;
+    while (gCuckooAdd(filter, &next) == 0) {
+        next += 2;
+    }
+    double load = (double) filter->count / (filter->nbuckets * CUCKOO_BUCKET_SLOTS);
+    if (gErrorCode != G_EFULL || load < 0.9) {
+        fprintf(stderr, "%u bits: full at load %.3f\n", bits, load);
+        return 1;
+    }
+    printf("%2u bits: false positive rate %.4f, full at load %.3f\n", bits, rate, load);
+    gCuckooDelete(filter);
+    return 0;
+}
+
+int main(void) {
+    for (long long i = 0; i < N_KEYS; ++i) {
+        keys[i] = i * 2;
+        absent[i] = i * 2 + 1;
+    }
+    return check(8, 0.035) || check(12, 0.003) || check(16, 0.0003);
+}
@@ -0,0 +1,68 @@
+#include <generic/hashmap.h>
+#include <stdio.h>
+
+#define N_KEYS 100000
+
+int main(void) {
+    gHashMap *map = gHashMapCreate(sizeof(int), sizeof(long long), NULL, NULL);
+    for (int i = 0; i < N_KEYS; ++i) {
+        long long value = (long long) i * 3;
+        if (gHashMapPut(map, &i, &value) != 0) {
+            fprintf(stderr, "%d: put failed\n", i);
+            return 1;
+        }
+    }
+    // Overwrite, the size must not change
+    for (int i = 0; i < N_KEYS; i += 10) {
+        long long value = -i;
+        gHashMapPut(map, &i, &value);
+    }
+    if (map->size != N_KEYS) {
+        fprintf(stderr, "size %zu, expected %d\n", map->size, N_KEYS);
+        return 1;
+    }
+    // Remove every odd key
+    for (int i = 1; i < N_KEYS; i += 2) {
+        if (gHashMapRemove(map, &i) != 0) {
+            fprintf(stderr, "%d: remove failed\n", i);
+            return 1;
+        }
+    }
+    for (int i = 0; i < 2 * N_KEYS; ++i) {
+        long long *value = (long long *) gHashMapGet(map, &i);
+        if (i >= N_KEYS || i % 2 == 1) {
+            if (value != NULL) {
+                fprintf(stderr, "%d: found after removal\n", i);
+                return 1;
+            }
+            continue;
+        }
+        long long expected = i % 10 == 0 ? -i : (long long) i * 3;
+        if (value == NULL || *value != expected) {
+            fprintf(stderr, "%d: wrong value\n", i);
+            return 1;
+        }
+    }
+    int missing = N_KEYS + 1;
+    if (gHashMapRemove(map, &missing) != G_ENOITM) {
+        fprintf(stderr, "removing a missing key must fail\n");
+        return 1;
+    }
+    size_t pos = 0, count = 0;
+    void *key, *value;
+    while (gHashMapIterate(map, &pos, &key, &value) == 0) {
+        count++;
+    }
+    if (count != map->size || count != N_KEYS / 2) {
+        fprintf(stderr, "iterated %zu entries, size %zu\n", count, map->size);
+        return 1;
+    }
+    if (gHashMapReserve(map, SIZE_MAX) != G_ENOMEN || gHashMapIterate(NULL, &pos, &key, &value) != G_EINVLD) {
+        fprintf(stderr, "impossible reserve or NULL map accepted\n");
+        return 1;
+    }
+    printf("%zu entries in %zu slots\n", map->size, map->capacity);
+
+    gHashMapDelete(map);
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <generic/heap.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 20000
+
+struct job {
+    long long priority;
+    int id;
+};
+
+static int compareJobs(void *a, void *b) {
+    long long x = ((struct job *) a)->priority, y = ((struct job *) b)->priority;
+    return (x > y) - (x < y);
+}
+
+static int drain(gHeap *heap, size_t expected, const char *what) {
+    struct job job, last = {-1, 0};
+    size_t count = 0;
+    while (gHeapPop(heap, &job) == 0) {
+        if (job.priority < last.priority) {
+            fprintf(stderr, "%s, arity %u: popped out of order\n", what, heap->arity);
+            return 1;
+        }
+        last = job;
+        count++;
+    }
+    if (count != expected || gHeapTop(heap) != NULL) {
+        fprintf(stderr, "%s, arity %u: popped %zu of %zu\n", what, heap->arity, count, expected);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    static struct job jobs[N];
+    unsigned int arity;
+    size_t i;
+    for (i = 0; i < N; ++i) {
+        jobs[i].priority = rand() % 1000;
+        jobs[i].id = (int) i;
+    }
+    for (arity = 2; arity <= 4; arity += 2) {
+        gHeap *heap = gHeapCreate(sizeof(struct job), arity, compareJobs);
+        for (i = 0; i < N; ++i) {
+            gHeapPush(heap, &jobs[i]);
+        }
+        if (drain(heap, N, "push")) {
+            return 1;
+        }
+        // Heapify on top of a few pushed elements
+        gHeapPush(heap, &jobs[0]);
+        gHeapPush(heap, &jobs[1]);
+        gHeapHeapify(heap, jobs + 2, N - 2);
+        if (drain(heap, N, "heapify")) {
+            return 1;
+        }
+        // Keep the 100 largest priorities with replace-top
+        gHeapHeapify(heap, jobs, 100);
+        for (i = 100; i < N; ++i) {
+            if (compareJobs(&jobs[i], gHeapTop(heap)) > 0) {
+                gHeapReplaceTop(heap, &jobs[i], NULL);
+            }
+        }
+        if (((struct job *) gHeapTop(heap))->priority < 990 || drain(heap, 100, "replace-top")) {
+            fprintf(stderr, "arity %u: wrong top 100\n", arity);
+            return 1;
+        }
+        if (gHeapPop(heap, NULL) != G_ENOITM || gHeapReplaceTop(heap, &jobs[0], NULL) != G_ENOITM) {
+            fprintf(stderr, "arity %u: empty heap not reported\n", arity);
+            return 1;
+        }
+        gHeapDelete(heap);
+    }
+    if (gHeapCreate(sizeof(struct job), 3, compareJobs) != NULL) {
+        fprintf(stderr, "arity 3 accepted\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <generic/indexedheap.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define V 600
+#define E 6000
+#define INF 0x3fffffffffffffffLL
+
+struct entry {
+    long long dist;
+    int vertex;
+};
+
+static int compareEntries(void *a, void *b) {
+    long long x = ((struct entry *) a)->dist, y = ((struct entry *) b)->dist;
+    return (x > y) - (x < y);
+}
+
+static long long weights[V][V];
+
+static void naive(long long *dist) {
+    static char done[V];
+    int i, u, v;
+    for (i = 0; i < V; ++i) {
+        dist[i] = INF;
+        done[i] = 0;
+    }
+    dist[0] = 0;
+    for (i = 0; i < V; ++i) {
+        u = -1;
+        for (v = 0; v < V; ++v) {
+            if (!done[v] && (u < 0 || dist[v] < dist[u])) {
+                u = v;
+            }
+        }
+        if (dist[u] == INF) {
+            break;
+        }
+        done[u] = 1;
+        for (v = 0; v < V; ++v) {
+            if (weights[u][v] && dist[u] + weights[u][v] < dist[v]) {
+                dist[v] = dist[u] + weights[u][v];
+            }
+        }
+    }
+}
+
+static void dijkstra(gIndexedHeap *heap, long long *dist) {
+    static size_t handles[V];
+    struct entry e;
+    int u, v;
+    for (v = 0; v < V; ++v) {
+        dist[v] = INF;
+        handles[v] = INDEXED_HEAP_NONE;
+    }
+    dist[0] = 0;
+    e.dist = 0;
+    e.vertex = 0;
+    gIndexedHeapPush(heap, &e, &handles[0]);
+    while (gIndexedHeapPop(heap, &e, NULL) == 0) {
+        u = e.vertex;
+        handles[u] = INDEXED_HEAP_NONE;
+        for (v = 0; v < V; ++v) {
+            if (!weights[u][v] || dist[u] + weights[u][v] >= dist[v]) {
+                continue;
+            }
+            e.dist = dist[v] = dist[u] + weights[u][v];
+            e.vertex = v;
+            if (handles[v] == INDEXED_HEAP_NONE) {
+                gIndexedHeapPush(heap, &e, &handles[v]);
+            } else if (gIndexedHeapDecreaseKey(heap, handles[v], &e) != 0) {
+                fprintf(stderr, "decrease-key failed for vertex %d\n", v);
+                exit(1);
+            }
+        }
+    }
+}
+
+int main(void) {
+    static long long expected[V], actual[V];
+    struct entry e, top;
+    size_t handles[8], handle;
+    int i;
+    for (i = 0; i < E; ++i) {
+        weights[rand() % V][rand() % V] = 1 + rand() % 1000;
+    }
+    naive(expected);
+    gIndexedHeap *heap = gIndexedHeapCreate(sizeof(struct entry), compareEntries);
+    dijkstra(heap, actual);
+    for (i = 0; i < V; ++i) {
+        if (expected[i] != actual[i]) {
+            fprintf(stderr, "vertex %d: distance %lld, expected %lld\n", i, actual[i], expected[i]);
+            return 1;
+        }
+    }
+    // Remove, increase-key and stale handles
+    for (i = 0; i < 8; ++i) {
+        e.dist = i * 10;
+        e.vertex = i;
+        gIndexedHeapPush(heap, &e, &handles[i]);
+    }
+    e.dist = 5;
+    e.vertex = 4;
+    if (gIndexedHeapIncreaseKey(heap, handles[4], &e) != G_EINVAL) {
+        fprintf(stderr, "increase-key accepted a smaller element\n");
+        return 1;
+    }
+    e.dist = 100;
+    e.vertex = 0;
+    gIndexedHeapIncreaseKey(heap, handles[0], &e);
+    gIndexedHeapRemove(heap, handles[1], &e);
+    if (e.vertex != 1 || gIndexedHeapGet(heap, handles[1]) != NULL ||
+        gIndexedHeapRemove(heap, handles[1], NULL) != G_ENOITM) {
+        fprintf(stderr, "removed handle still in use\n");
+        return 1;
+    }
+    e.dist = 1;
+    e.vertex = 1;
+    gIndexedHeapPush(heap, &e, &handle);
+    if (handle != handles[1]) {
+        fprintf(stderr, "freed handle not reused\n");
+        return 1;
+    }
+    int order[] = {1, 2, 3, 4, 5, 6, 7, 0};
+    for (i = 0; i < 8; ++i) {
+        if (gIndexedHeapPop(heap, &top, NULL) != 0 || top.vertex != order[i]) {
+            fprintf(stderr, "pop %d: got vertex %d, expected %d\n", i, top.vertex, order[i]);
+            return 1;
+        }
+    }
+    if (gIndexedHeapPop(heap, &top, NULL) != G_ENOITM) {
+        fprintf(stderr, "popped from an empty heap\n");
+        return 1;
+    }
+    gIndexedHeapDelete(heap);
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <generic/itree.h>
+#include <stdio.h>
+
+#define N_INTERVALS 2000
+#define N_QUERIES   500
+
+long long lows[N_INTERVALS];
+long long highs[N_INTERVALS];
+
+int compare_ll(void *a, void *b) {
+    long long x = *(long long *) a;
+    long long y = *(long long *) b;
+    return (x > y) - (x < y);
+}
+
+int check_order(ivl_node_t *node, void *ctx) {
+    long long *last = (long long *) ctx;
+    long long lo = *(long long *) node->lo;
+    if (lo < *last) {
+        return 1;
+    }
+    *last = lo;
+    return 0;
+}
+
+int main(void) {
+    gIntervalTree *tree = gIntervalTreeCreate(sizeof(long long), sizeof(int), compare_ll);
+    srand(42);
+    for (int i = 0; i < N_INTERVALS; ++i) {
+        lows[i] = rand() % 100000;
+        highs[i] = lows[i] + rand() % 500;
+        if (gIntervalTreeAdd(tree, &lows[i], &highs[i], &i) != 0) {
+            fprintf(stderr, "Failed to add interval %d\n", i);
+            return 1;
+        }
+    }
+    long long bad_lo = 10, bad_hi = 5;
+    if (gIntervalTreeAdd(tree, &bad_lo, &bad_hi, NULL) == 0) {
+        fprintf(stderr, "Inverted interval was accepted\n");
+        return 1;
+    }
+    // 2000 nodes, an AVL tree is never taller than 1.44 * lg(n)
+    if (tree->root->height > 16) {
+        fprintf(stderr, "Tree is unbalanced, height %d\n", tree->root->height);
+        return 1;
+    }
+
+    for (int q = 0; q < N_QUERIES; ++q) {
+        long long lo = rand() % 100000;
+        long long hi = lo + rand() % 1000;
+        size_t point_expected = 0, range_expected = 0;
+        for (int i = 0; i < N_INTERVALS; ++i) {
+            if (lows[i] <= lo && lo <= highs[i]) point_expected++;
+            if (lows[i] <= hi && highs[i] >= lo) range_expected++;
+        }
+        long long last = -1;
+        size_t point_found = gIntervalOverlaps(tree, &lo, check_order, &last);
+        last = -1;
+        size_t range_found = gIntervalOverlapsRange(tree, &lo, &hi, check_order, &last);
+        if (point_found != point_expected || range_found != range_expected) {
+            fprintf(stderr, "Query [%lld, %lld]: found %zu/%zu, expected %zu/%zu\n",
+                    lo, hi, point_found, range_found, point_expected, range_expected);
+            return 1;
+        }
+    }
+    printf("%d intervals, height %d, %d queries matched\n", N_INTERVALS, tree->root->height, N_QUERIES);
+
+    gIntervalTreeDelete(tree);
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <generic/countmin.h>
+#include <stdio.h>
+#include <string.h>
+
+#define N_KEYS 10000
+#define TOP 10
+
+int counts[N_KEYS];
+
+int main(void) {
+    gCountMin *cms = gCountMinCreate(sizeof(int), 0.001, 0.01, 1, TOP);
+    gCountMin *plain = gCountMinCreate(sizeof(int), 0.001, 0.01, 0, 0);
+    // Key k is added N / (k + 1) + 1 times
+    size_t n = 0;
+    for (int key = 0; key < N_KEYS; ++key) {
+        counts[key] = N_KEYS / (key + 1) + 1;
+        n += counts[key];
+    }
+    int *stream = malloc(sizeof(int) * n);
+    n = 0;
+    for (int key = 0; key < N_KEYS; ++key) {
+        for (int i = 0; i < counts[key]; ++i) {
+            stream[n++] = key;
+        }
+    }
+    gCountMinAddBatch(cms, stream, n / 2);
+    for (size_t i = n / 2; i < n; ++i) {
+        gCountMinAdd(cms, &stream[i], 1);
+    }
+    gCountMinAddBatch(plain, stream, n);
+    for (int key = 0; key < N_KEYS; ++key) {
+        uint64_t estimate = gCountMinEstimate(cms, &key);
+        if (estimate < (uint64_t) counts[key] || estimate > gCountMinEstimate(plain, &key)) {
+            fprintf(stderr, "%d: estimate %llu for %d\n", key, (unsigned long long) estimate, counts[key]);
+            return 1;
+        }
+    }
+
+    int top[TOP];
+    uint64_t topCounts[TOP];
+    if (gCountMinTopK(cms, top, topCounts) != TOP) {
+        fprintf(stderr, "top-k incomplete\n");
+        return 1;
+    }
+    for (int i = 0; i < TOP; ++i) {
+        if (top[i] != i) {
+            fprintf(stderr, "top %d is key %d\n", i, top[i]);
+            return 1;
+        }
+    }
+
+    size_t size = gCountMinSerialize(cms, NULL, 0);
+    void *buf = malloc(size);
+    gCountMinSerialize(cms, buf, size);
+    gCountMin *copy = gCountMinDeserialize(buf, size);
+    int copyTop[TOP];
+    if (copy == NULL || copy->total != n || gCountMinTopK(copy, copyTop, NULL) != TOP || copyTop[0] != 0) {
+        fprintf(stderr, "deserialized sketch differs\n");
+        return 1;
+    }
+    // Corrupted headers: a key size that wraps the entry size, an impossible top-k
+    unsigned char *bad = malloc(size);
+    memcpy(bad, buf, size);
+    memset(bad + 16, 0xff, 8);
+    bad[16] = 0xf8;
+    if (gCountMinDeserialize(bad, size) != NULL || gErrorCode != G_EINVAL) {
+        fprintf(stderr, "huge key size accepted\n");
+        return 1;
+    }
+    memcpy(bad, buf, size);
+    memset(bad + 40, 0xff, 8);
+    if (gCountMinDeserialize(bad, size) != NULL) {
+        fprintf(stderr, "huge top-k accepted\n");
+        return 1;
+    }
+    free(bad);
+    gCountMinMerge(copy, cms);
+    int key = 0;
+    if (gCountMinEstimate(copy, &key) < 2 * (uint64_t) counts[0]) {
+        fprintf(stderr, "merged estimate too small\n");
+        return 1;
+    }
+    printf("%zu keys, top estimate %llu\n", n, (unsigned long long) topCounts[0]);
+    free(buf);
+    free(stream);
+    gCountMinDelete(copy);
+    gCountMinDelete(plain);
+    gCountMinDelete(cms);
+    return 0;
+}
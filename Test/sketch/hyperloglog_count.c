@@ -0,0 +1,66 @@
+#include <generic/hyperloglog.h>
+#include <math.h>
+#include <stdio.h>
+
+#define N_KEYS 200000
+
+long long keys[N_KEYS];
+
+static int near(const char *what, double estimate, double expected, double tolerance) {
+    if (fabs(estimate - expected) > tolerance * expected) {
+        fprintf(stderr, "%s: estimate %.0f, expected %.0f\n", what, estimate, expected);
+        return 0;
+    }
+    return 1;
+}
+
+int main(void) {
+    for (long long i = 0; i < N_KEYS; ++i) {
+        keys[i] = i;
+    }
+    // p = 12, standard error 1.6%
+    gHLL *a = gHLLCreate(sizeof(long long), 12);
+    gHLL *b = gHLLCreate(sizeof(long long), 12);
+    if (gHLLCount(a) != 0) {
+        fprintf(stderr, "empty sketch counts %.0f\n", gHLLCount(a));
+        return 1;
+    }
+    for (int i = 0; i < 100; ++i) {
+        gHLLAdd(a, &keys[i % 50]);
+    }
+    if (a->registers != NULL || !near("sparse", gHLLCount(a), 50, 0.02)) {
+        return 1;
+    }
+    gHLLAddBatch(a, keys, N_KEYS / 2);
+    gHLLAddBatch(b, keys + N_KEYS / 4, N_KEYS * 3 / 4);
+    if (a->registers == NULL || !near("dense", gHLLCount(a), N_KEYS / 2, 0.06)) {
+        return 1;
+    }
+
+    size_t size = gHLLSerialize(b, NULL, 0);
+    void *buf = malloc(size);
+    gHLLSerialize(b, buf, size);
+    gHLL *copy = gHLLDeserialize(buf, size);
+    if (copy == NULL || gHLLCount(copy) != gHLLCount(b)) {
+        fprintf(stderr, "deserialized sketch differs\n");
+        return 1;
+    }
+    free(buf);
+
+    // Union of [0, N/2) and [N/4, N)
+    gHLLMerge(a, copy);
+    if (!near("merged", gHLLCount(a), N_KEYS, 0.06)) {
+        return 1;
+    }
+    gHLL *small = gHLLCreate(sizeof(long long), 10);
+    if (gHLLMerge(a, small) != G_EINVAL) {
+        fprintf(stderr, "merged sketches of different precisions\n");
+        return 1;
+    }
+    printf("estimates %.0f of %d\n", gHLLCount(a), N_KEYS);
+    gHLLDelete(small);
+    gHLLDelete(copy);
+    gHLLDelete(b);
+    gHLLDelete(a);
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include <generic/splay.h>
+#include <stdio.h>
+
+#define N_ITEMS 10000
+
+int main(void) {
+    gSplay *tree = gSplayCreate(sizeof(int), gINT_COMPARE);
+    // Sorted input, worst case for the shape of a splay tree
+    for (int i = 0; i < N_ITEMS; i += 2) {
+        gSplayAdd(tree, &i);
+    }
+    srand(7);
+    for (int i = 0; i < N_ITEMS; ++i) {
+        int key = rand() % N_ITEMS;
+        bnode_t *found = gSplaySearch(tree, &key);
+        if ((key % 2 == 0) != (found != NULL)) {
+            fprintf(stderr, "%d: wrong search result\n", key);
+            return 1;
+        }
+        if (found != NULL && found != tree->root) {
+            fprintf(stderr, "%d: not splayed to the root\n", key);
+            return 1;
+        }
+    }
+    int hot = 4242;
+    gSplaySearch(tree, &hot);
+    if (*(int *) tree->root->data != hot) {
+        fprintf(stderr, "%d: expected at the root\n", hot);
+        return 1;
+    }
+    printf("%zu items, searches matched\n", tree->size);
+
+    gSplayDelete(tree);
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <generic/timerwheel.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 50000
+#define SPAN (1 << 21)
+
+struct connection {
+    gTimer timeout;
+    int fired;
+    int periodic;
+};
+
+static struct connection connections[N];
+static gTimerWheel *wheel;
+static int errors;
+
+static uint64_t random64(void) {
+    return ((uint64_t) rand() << 31) ^ (uint64_t) rand();
+}
+
+static void expire(gTimer *timer, void *arg) {
+    struct connection *c = gDLIST_ENTRY(timer, struct connection, timeout);
+    (void) arg;
+    // The tick being fired is wheel->tick - 1
+    if (timer->expires != wheel->tick - 1 || gTimerPending(timer)) {
+        if (errors++ < 5) {
+            fprintf(stderr, "timer %d for tick %llu fired at %llu\n", (int) (c - connections),
+                    (unsigned long long) timer->expires, (unsigned long long) wheel->tick - 1);
+        }
+    }
+    c->fired++;
+    if (c->periodic) {
+        gTimerWheelSchedule(wheel, timer, timer->expires + 1000);
+    }
+}
+
+int main(void) {
+    uint64_t now = 12345, pending = 0;
+    size_t i, fired = 0;
+    gTimer far;
+    wheel = gTimerWheelCreate(now);
+    gTimerInit(&far);
+    gTimerWheelSchedule(wheel, &far, now + ((uint64_t) 1 << 40));
+    for (i = 0; i < N; ++i) {
+        gTimerInit(&connections[i].timeout);
+        gTimerWheelSchedule(wheel, &connections[i].timeout, now + random64() % SPAN);
+    }
+    connections[0].periodic = 1;
+    // Reschedule and cancel some timers, as connections see traffic or close
+    for (i = 0; i < N; i += 3) {
+        gTimerWheelSchedule(wheel, &connections[i].timeout, now + random64() % SPAN);
+    }
+    for (i = 1; i < N; i += 7) {
+        gTimerWheelCancel(wheel, &connections[i].timeout);
+    }
+    if (gTimerWheelCancel(wheel, &connections[1].timeout) != G_ENOITM) {
+        fprintf(stderr, "cancelled an idle timer\n");
+        return 1;
+    }
+    pending = wheel->n;
+    while (now < 12345 + SPAN) {
+        now += 1 + random64() % 5000;
+        fired += gTimerWheelAdvance(wheel, now, expire, NULL);
+    }
+    gTimerWheelCancel(wheel, &connections[0].timeout);
+    for (i = 1; i < N; ++i) {
+        if (connections[i].fired != (i % 7 != 1)) {
+            fprintf(stderr, "timer %zu fired %d times\n", i, connections[i].fired);
+            return 1;
+        }
+    }
+    if (errors || wheel->n != 1 || fired != pending - 2 + connections[0].fired || !gTimerPending(&far)) {
+        fprintf(stderr, "%d early or late timers, %zu fired, %zu left\n", errors, fired, wheel->n);
+        return 1;
+    }
+    if (gTimerWheelAdvance(NULL, now, expire, NULL) != 0 || gTimerWheelAdvance(wheel, now + 1, NULL, NULL) != 0
+        || gErrorCode != G_EINVLD) {
+        fprintf(stderr, "advanced without a wheel or callback\n");
+        return 1;
+    }
+    gTimerWheelDelete(wheel);
+    if (gTimerPending(&far)) {
+        fprintf(stderr, "timer still linked after delete\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <generic/typed.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 100000
+
+struct point {
+    int key;
+    int id;
+};
+
+#define LESS_INT(a, b) ((a) < (b))
+#define LESS_POINT(a, b) ((a).key < (b).key)
+
+GVECTOR_DEFINE(PointVector, struct point)
+GHEAP_DEFINE(IntHeap, int, LESS_INT)
+GSORT_DEFINE(sortInts, int, LESS_INT)
+GSORT_DEFINE(sortPoints, struct point, LESS_POINT)
+
+static int compareInts(const void *a, const void *b) {
+    int x = *(const int *) a, y = *(const int *) b;
+    return (x > y) - (x < y);
+}
+
+static int checkSort(int *a, int *b, size_t n, const char *what) {
+    size_t i;
+    sortInts(a, n);
+    qsort(b, n, sizeof(int), compareInts);
+    for (i = 0; i < n; ++i) {
+        if (a[i] != b[i]) {
+            fprintf(stderr, "sort of %s input differs at %zu\n", what, i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    static int a[N], b[N];
+    PointVector points;
+    IntHeap heap;
+    struct point p, *q;
+    size_t i;
+    int last, x;
+
+    for (i = 0; i < N; ++i) a[i] = b[i] = rand();
+    if (checkSort(a, b, N, "random")) return 1;
+    for (i = 0; i < N; ++i) a[i] = b[i] = rand() % 4;
+    if (checkSort(a, b, N, "few values")) return 1;
+    for (i = 0; i < N; ++i) a[i] = b[i] = (int) (N - i);
+    if (checkSort(a, b, N, "descending")) return 1;
+    for (i = 0; i < N; ++i) a[i] = b[i] = i % 2 ? (int) i : (int) (N - i);
+    if (checkSort(a, b, N, "organ pipe")) return 1;
+
+    PointVectorCreate(&points);
+    for (i = 0; i < N; ++i) {
+        p.key = rand() % 1000;
+        p.id = (int) i;
+        PointVectorPushBack(&points, p);
+    }
+    p.key = -1;
+    PointVectorInsert(&points, 0, p);
+    q = PointVectorPopBack(&points);
+    if (points.n != N || PointVectorFront(&points)->key != -1 || q->id != N - 1) {
+        fprintf(stderr, "vector holds %zu points\n", points.n);
+        return 1;
+    }
+    sortPoints(points.elems, points.n);
+    for (i = 1; i < points.n; ++i) {
+        if (PointVectorItemAt(&points, i)->key < PointVectorItemAt(&points, i - 1)->key) {
+            fprintf(stderr, "points out of order at %zu\n", i);
+            return 1;
+        }
+    }
+    PointVectorDestroy(&points);
+
+    IntHeapCreate(&heap);
+    for (i = 0; i < N; ++i) {
+        IntHeapPush(&heap, rand() % 10000);
+    }
+    IntHeapReplaceTop(&heap, 5000, NULL);
+    for (last = -1, i = 0; IntHeapPop(&heap, &x) == 0; ++i, last = x) {
+        if (x < last) {
+            fprintf(stderr, "heap popped %d after %d\n", x, last);
+            return 1;
+        }
+    }
+    if (i != N || IntHeapTop(&heap) != NULL) {
+        fprintf(stderr, "heap popped %zu of %d\n", i, N);
+        return 1;
+    }
+    IntHeapDestroy(&heap);
+    return 0;
+}
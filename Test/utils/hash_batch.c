@@ -0,0 +1,59 @@
+#include <generic/hash.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N_KEYS 1000
+
+unsigned char keys[N_KEYS * 40];
+uint64_t hashes[N_KEYS];
+
+int check_batch(size_t keySize) {
+    gHashBatch(keys, N_KEYS, keySize, hashes);
+    for (size_t i = 0; i < N_KEYS; ++i) {
+        if (hashes[i] != gHashBytes(keys + i * keySize, keySize)) {
+            fprintf(stderr, "key size %zu: batch differs at %zu\n", keySize, i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    srand(1);
+    for (size_t i = 0; i < sizeof(keys); ++i) {
+        keys[i] = (unsigned char) rand();
+    }
+    size_t sizes[] = {1, 3, 4, 7, 8, 12, 16, 17, 33, 40};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        if (check_batch(sizes[i])) {
+            return 1;
+        }
+    }
+
+    uint32_t x32 = 0xdeadbeef;
+    uint64_t x64 = 0x0123456789abcdefull;
+    if (gHashBytes(&x32, 4) != gHashU32(x32) || gHashBytes(&x64, 8) != gHashU64(x64)
+        || gHashBytes(keys, 16) != gHash128(keys) || gHashBytesSeed(keys, 16, 0) != gHash128(keys)) {
+        fprintf(stderr, "specialized hashes differ from gHashBytes\n");
+        return 1;
+    }
+    if (gHashBytesSeed(keys, 16, 1) == gHashBytesSeed(keys, 16, 2)) {
+        fprintf(stderr, "seed is ignored\n");
+        return 1;
+    }
+
+    // Flipping any input bit of sequential integers should flip about half of the output bits
+    double flipped = 0;
+    for (uint64_t i = 0; i < N_KEYS; ++i) {
+        for (int bit = 0; bit < 64; ++bit) {
+            flipped += __builtin_popcountll(gHashU64(i) ^ gHashU64(i ^ (1ull << bit)));
+        }
+    }
+    flipped /= N_KEYS * 64.0;
+    if (flipped < 31 || flipped > 33) {
+        fprintf(stderr, "poor avalanche: %.2f bits flipped\n", flipped);
+        return 1;
+    }
+    printf("Batch hashes match, %.2f of 64 bits flip on average\n", flipped);
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <generic/utils.h>
+#include <stdio.h>
+#include <string.h>
+
+#define N 200
+#define MAX_SZ 40
+
+static unsigned char data[N * MAX_SZ];
+static unsigned char expect[N * MAX_SZ];
+
+static void fill(size_t n, size_t sz) {
+    size_t i;
+    for (i = 0; i < n * sz; i++) {
+        data[i] = (unsigned char) (i * 7 + i / sz);
+    }
+}
+
+int main(void) {
+    const size_t sizes[] = {1, 2, 3, 4, 8, 12, 16, 40};
+    size_t s, n, i, k;
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t sz = sizes[s];
+        for (n = 0; n <= N; n += n < 80 ? 1 : 31) {
+            fill(n, sz);
+            for (i = 0; i < n; i++) {
+                memcpy(expect + i * sz, data + (n - 1 - i) * sz, sz);
+            }
+            if (gReverse(data, n, sz) != data || memcmp(data, expect, n * sz) != 0) {
+                printf("reverse of %zu elements of %zu bytes is wrong\n", n, sz);
+                return 1;
+            }
+            for (k = 0; k <= n; k++) {
+                fill(n, sz);
+                for (i = 0; i < n; i++) {
+                    memcpy(expect + i * sz, data + (k < n ? (i + k) % n : i) * sz, sz);
+                }
+                gRotate(data, n, sz, k);
+                if (memcmp(data, expect, n * sz) != 0) {
+                    printf("rotate of %zu elements of %zu bytes by %zu is wrong\n", n, sz, k);
+                    return 1;
+                }
+            }
+        }
+        /* Swapping ranges of every length */
+        for (n = 0; n < N * MAX_SZ / 2; n += n < 70 ? 1 : 333) {
+            fill(N, MAX_SZ);
+            memcpy(expect, data + N * MAX_SZ / 2, n);
+            memcpy(expect + N * MAX_SZ / 2, data, n);
+            gSwap(data, data + N * MAX_SZ / 2, n);
+            if (memcmp(data, expect, n) != 0 || memcmp(data + N * MAX_SZ / 2, expect + N * MAX_SZ / 2, n) != 0) {
+                printf("swap of %zu bytes is wrong\n", n);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <generic/utils.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 300
+
+int main(void) {
+    int32_t i32[N];
+    int64_t i64[N];
+    uint8_t u8[N];
+    float f32[N];
+    size_t n, pos, i;
+    for (n = 0; n <= N; n += n < 70 ? 1 : 23) {
+        for (i = 0; i < n; i++) {
+            i32[i] = (int32_t) i;
+            i64[i] = (int64_t) i << 33 | 1;
+            u8[i] = (uint8_t) (i % 200);
+            f32[i] = (float) i + 0.5f;
+        }
+        /* Every position, including the scalar tail, and a duplicate after it */
+        for (pos = 0; pos < n; pos++) {
+            if (pos + 1 < n) {
+                i32[n - 1] = (int32_t) pos;
+                i64[n - 1] = (int64_t) pos << 33 | 1;
+                f32[n - 1] = (float) pos + 0.5f;
+            }
+            if (gSearchI32(i32, n, (int32_t) pos) != i32 + pos
+                || gSearchI64(i64, n, (int64_t) pos << 33 | 1) != i64 + pos
+                || gSearchF32(f32, n, (float) pos + 0.5f) != f32 + pos
+                || (pos < 200 && gSearchU8(u8, n, (uint8_t) pos) != u8 + pos)) {
+                printf("n=%zu: %zu not found first\n", n, pos);
+                return 1;
+            }
+            i32[n - 1] = (int32_t) (n - 1);
+            i64[n - 1] = (int64_t) (n - 1) << 33 | 1;
+            f32[n - 1] = (float) (n - 1) + 0.5f;
+        }
+        /* A 64 bit key whose low half matches */
+        if (gSearchI32(i32, n, -1) != NULL
+            || gSearchI64(i64, n, (int64_t) 1 << 32 | 1) != NULL
+            || gSearchU8(u8, n, 255) != NULL
+            || gSearchF32(f32, n, 0.0f) != NULL) {
+            printf("n=%zu: missing key found\n", n);
+            return 1;
+        }
+    }
+    f32[0] = -0.0f;
+    if (gSearchF32(f32, 1, 0.0f) != f32) {
+        printf("-0.0 does not match 0.0\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <generic/vector.h>
+#include <generic/list.h>
+#include <stdio.h>
+
+#ifndef GENERIC_INLINE
+#error "generic_inline should define GENERIC_INLINE"
+#endif
+
+int main(void) {
+    gVector vec;
+    gList *list;
+    gListIterator iter;
+    long sum = 0;
+    int i;
+    gVectorCreate(&vec, sizeof(int));
+    for (i = 0; i < 10; ++i) {
+        gVectorPushBack(&vec, &i);
+    }
+    for (i = 0; i < 10; ++i) {
+        int twice = 2 * *(int *) gVectorItemAt(&vec, i);
+        gVectorSet(&vec, i, &twice);
+    }
+    for (i = 0; i < 10; ++i) {
+        sum += *(int *) gVectorItemAt(&vec, i);
+    }
+    if (sum != 90 || *(int *) gVectorFront(&vec) != 0 || *(int *) gVectorBack(&vec) != 18) {
+        fprintf(stderr, "vector sum %ld\n", sum);
+        return 1;
+    }
+    gVectorDestroy(&vec);
+
+    list = gListCreate(sizeof(int));
+    for (i = 0; i < 3; ++i) {
+        gListAddItem(list, &i);
+    }
+    iter = gListGetIterator(list);
+    for (sum = 0; gListGetIteratorData(iter) != NULL; gListIterate(iter)) {
+        sum += *(int *) gListGetIteratorData(iter);
+    }
+    if (sum != 3 || gErrorCode != G_EITMEND) {
+        fprintf(stderr, "list sum %ld\n", sum);
+        return 1;
+    }
+    free(iter);
+    gListDelete(list);
+    return 0;
+}
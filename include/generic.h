@@ -41,8 +41,41 @@ typedef int (*cmpfunc_t)(void *a,void *b);
 #define G_ENOITM        6   /* Instance Empty */
 #define G_EITMEND       9   /* End of Linear Data Structure */
 #define G_EINVLD        2   /* Invalid container */
+#define G_EFULL         28  /* Container is full */
+#define G_EIO           5   /* Input/output error, see errno */
 
 extern int gErrorCode;
 
+/** @brief Checks of the accessors that may be inlined
+ *
+ * They cost more than the accessors themselves, so they are only
+ * compiled in with GENERIC_DEBUG, whatever NDEBUG says.
+ */
+#ifdef GENERIC_DEBUG
+#include <stdio.h>
+#include <stdlib.h>
+#define G_DEBUG_ASSERT(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, __func__, #cond); \
+            abort(); \
+        } \
+    } while (0)
+#else
+#define G_DEBUG_ASSERT(cond)    ((void) 0)
+#endif
+
+/** @brief Linkage of the hot accessors
+ *
+ * With GENERIC_INLINE (or the generic_inline CMake target) the headers
+ * define them static inline, so loops over the elements need no call.
+ * Otherwise they are functions of the library.
+ */
+#ifdef GENERIC_INLINE
+#define G_ACCESSOR  static inline
+#else
+#define G_ACCESSOR
+#endif
+
 
 #endif //DATA_STRUCTURE_ST_DATA_STRUCTURE_H
@@ -31,4 +31,18 @@
 #include <generic.h>
 /* Merge Sort */
 #include <generic/algorithm/mergesort.h>
+/* Pattern-defeating Quicksort */
+#include <generic/algorithm/pdqsort.h>
+/* Radix Sort */
+#include <generic/algorithm/radixsort.h>
+/* Timsort */
+#include <generic/algorithm/timsort.h>
+/* External Sort */
+#include <generic/algorithm/extsort.h>
+/* K-way Merge */
+#include <generic/algorithm/mergek.h>
+/* Binary Search */
+#include <generic/algorithm/binarysearch.h>
+/* Selection */
+#include <generic/algorithm/select.h>
 #endif
@@ -0,0 +1,102 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+/**
+ * @file	binarysearch.h
+ *
+ * @brief	Searching sorted arrays
+ */
+#ifndef	ALGORITHM_BINARYSEARCH_H
+#define	ALGORITHM_BINARYSEARCH_H
+#include <stddef.h>	// size_t
+#include <stdint.h>
+#include <generic/algorithm.h>
+/** @defgroup binarysearch Binary Search
+ *
+ * The searches halve the range without branching on the comparison: the
+ * next base is picked with a conditional move, so the loop runs
+ * ceil(log2 n) times whatever the data and never mispredicts. On arrays
+ * larger than the caches the cost is the memory latency of each probe, so
+ * the two candidates for the probe after next are prefetched, overlapping
+ * the misses of consecutive levels.
+ *
+ * The arrays must be sorted according to the comparison function, or in
+ * ascending order for the typed variants. Positions are indices, n means
+ * past the end.
+ *
+ * @see https://arxiv.org/abs/1509.05053
+ *
+ * @{
+ */
+
+/** @brief First position whose element is not less than key
+ *
+ * @param key:	The element looked for
+ * @param base:	The sorted array
+ * @param n:	Length of the array
+ * @param elem_sz:	Size of each element
+ * @param cmpfunc:	Function for comparing the elements
+ *
+ * @return	Index of the first element >= key, n if there is none
+ */
+extern size_t gLowerBound(const void *key,const void *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc);
+
+/** @brief First position whose element is greater than key
+ *
+ * @return	Index of the first element > key, n if there is none
+ *
+ * @see	gLowerBound
+ */
+extern size_t gUpperBound(const void *key,const void *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc);
+
+/** @brief Range of the elements equal to key
+ *
+ * @param first:	Set to gLowerBound of key
+ * @param last:	Set to gUpperBound of key, first if key is not there
+ *
+ * @see	gLowerBound
+ */
+extern void gEqualRange(const void *key,const void *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,size_t *first,size_t *last);
+
+/** @brief Binary search of a sorted array
+ *
+ * @return	Pointer to the first element equal to key, NULL if not found
+ *
+ * @see	gLowerBound
+ */
+extern void *gBinarySearch(const void *key,const void *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc);
+
+/** @brief gLowerBound for an ascending array of int32_t */
+extern size_t gLowerBoundI32(const int32_t *base,size_t n,int32_t key);
+/** @brief gUpperBound for an ascending array of int32_t */
+extern size_t gUpperBoundI32(const int32_t *base,size_t n,int32_t key);
+/** @brief gLowerBound for an ascending array of int64_t */
+extern size_t gLowerBoundI64(const int64_t *base,size_t n,int64_t key);
+/** @brief gUpperBound for an ascending array of int64_t */
+extern size_t gUpperBoundI64(const int64_t *base,size_t n,int64_t key);
+/** @brief gLowerBound for an ascending array of uint64_t */
+extern size_t gLowerBoundU64(const uint64_t *base,size_t n,uint64_t key);
+/** @brief gUpperBound for an ascending array of uint64_t */
+extern size_t gUpperBoundU64(const uint64_t *base,size_t n,uint64_t key);
+/** @} */
+#endif
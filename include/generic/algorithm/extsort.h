@@ -0,0 +1,74 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+/**
+ * @file	extsort.h
+ *
+ * @brief	Sorting files of fixed size records larger than memory
+ */
+#ifndef	ALGORITHM_EXTSORT_H
+#define	ALGORITHM_EXTSORT_H
+#include <stddef.h>	// size_t
+#include <generic/algorithm.h>
+/** @defgroup extsort External Sort
+ *
+ * An external merge sort reads its input in chunks that fit the memory
+ * budget, sorts each one with gTimSort and writes it to a temporary file
+ * as a sorted run. The runs are then merged k at a time through a loser
+ * tree, which finds the next record in log k comparisons, reading each run
+ * and writing the output in blocks of at least 256 KiB. When there are
+ * too many runs for blocks that large, consecutive groups of runs are
+ * merged into longer runs first.
+ *
+ * Input that fits the budget is sorted in memory and never touches the
+ * temporary directory. Temporary files are unlinked as soon as they are
+ * created, so nothing is left behind if the process dies.
+ *
+ * @see https://en.wikipedia.org/wiki/External_sorting
+ *
+ * @{
+ */
+
+/** @brief External merge sort of fixed size records
+ *
+ * Reads records from in_fd until end of file and writes them sorted to
+ * out_fd. Both are used sequentially, so they may be pipes. The sort is
+ * stable.
+ *
+ * @param in_fd:	Descriptor the records are read from
+ * @param out_fd:	Descriptor the sorted records are written to
+ * @param elem_sz:	Size of each record
+ * @param cmpfunc:	Function for comparing the records
+ * @param mem_budget:	Bytes of memory the sort may use for records
+ * @param tmp_dir:	Directory for the runs, NULL for $TMPDIR or /tmp
+ *
+ * @return	status code of operation
+ *		(0) if success
+ *		G_EINVAL if the budget holds fewer than 4 records or the input
+ *		ends with a partial record
+ *		G_ENOMEN if the buffers could not be allocated
+ *		G_EIO if a read, write or temporary file failed, errno tells why
+ */
+extern int gExternalSort(int in_fd,int out_fd,size_t elem_sz,cmpfunc_t cmpfunc,size_t mem_budget,const char *tmp_dir);
+/** @} */
+#endif
@@ -0,0 +1,88 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+/**
+ * @file	mergek.h
+ *
+ * @brief	Merging k sorted arrays in one pass
+ */
+#ifndef	ALGORITHM_MERGEK_H
+#define	ALGORITHM_MERGEK_H
+#include <stddef.h>	// size_t
+#include <generic/algorithm.h>
+#include <generic/vector.h>
+/** @defgroup mergek K-way Merge
+ *
+ * The k inputs are merged through a loser tree, a tournament tree whose
+ * internal nodes remember the loser of the match played there. Once the
+ * head of the winning input is taken, only the matches on the path from
+ * its leaf to the root are replayed, so every output element costs
+ * ceil(log2 k) comparisons and every element is moved once. Merging
+ * pairwise instead reads and writes every element log k times.
+ *
+ * Once a single input is left it is copied as a block.
+ *
+ * @see https://en.wikipedia.org/wiki/K-way_merge_algorithm
+ *
+ * @{
+ */
+
+/** @brief K-way merge of sorted arrays
+ *
+ * The merge is stable: equal elements come out in the order of their
+ * inputs. The output must not overlap the inputs.
+ *
+ * @param inputs:	The k sorted arrays
+ * @param counts:	Length of each array, may be 0
+ * @param k:	Number of arrays
+ * @param elem_sz:	Size of each element
+ * @param cmpfunc:	Function for comparing the elements
+ * @param out:	Room for the sum of counts elements
+ *
+ * @return	Pointer to the merged array
+ *		Always equal to out on success
+ *		NULL if the tree for more than 64 inputs could not be
+ *		allocated (G_ENOMEN)
+ */
+extern void *gMergeK(void *const inputs[],const size_t counts[],size_t k,size_t elem_sz,cmpfunc_t cmpfunc,void *out);
+
+/** @brief K-way merge of sorted arrays to the end of a vector
+ *
+ * The elements are appended after the ones already in the vector, which
+ * grows once by the sum of counts.
+ *
+ * @param inputs:	The k sorted arrays, of elements of the vector's size
+ * @param counts:	Length of each array, may be 0
+ * @param k:	Number of arrays
+ * @param cmpfunc:	Function for comparing the elements
+ * @param out:	Vector the merged elements are appended to
+ *
+ * @return	status code of operation
+ *		(0) if success, G_ENOMEN if the vector could not grow or the
+ *		tree could not be allocated, the vector is then unchanged
+ *
+ * @see	gMergeK
+ */
+extern int gMergeKVector(void *const inputs[],const size_t counts[],size_t k,cmpfunc_t cmpfunc,gVector *out);
+/** @} */
+#endif
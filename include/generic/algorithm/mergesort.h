@@ -35,6 +35,13 @@
  * Merge sort is a sorting algorithm originally created by John von Neumann
  * in 1945.
  *
+ * This one works bottom-up: runs of 16 elements are sorted by insertion,
+ * then every level merges pairs of runs from the array into a scratch
+ * buffer of n elements or back, so each level reads and writes every
+ * element once. Adjacent runs already in order are copied without being
+ * merged. The sort is stable and takes O(n log n) time, O(n) extra memory
+ * and constant stack space.
+ *
  * @see https://en.wikipedia.org/wiki/Merge_sort
  *
  * @{
@@ -47,7 +54,8 @@
  *
  * @return	Pointer to the sorted array
  *		Always equal to the input on success
- *		NULL on failure
+ *		NULL if the scratch buffer could not be allocated
+ *		(G_ENOMEN), the array is then left unchanged
  */
 extern int *mergeSort(int *arr,size_t n);
 
@@ -60,11 +68,39 @@ extern int *mergeSort(int *arr,size_t n);
  *
  * @return	Pointer to the sorted array
  *		Always equal to the input on success
- *		NULL on failure
+ *		NULL if the scratch buffer could not be allocated
+ *		(G_ENOMEN), the array is then left unchanged
  *
  * @see	merge_sort
  */
 extern void *gMergeSort(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc);
+
+/** @brief Merge Sort for generic types on several threads
+ *
+ * The array is cut in one chunk per thread, each sorted by gMergeSort.
+ * The runs are then merged pairwise level by level, and every level is
+ * shared evenly by all the threads whatever the number of runs left: the
+ * output of a level is cut in equal parts and each thread finds where its
+ * part starts in the two runs by binary search (co-ranking, or merge
+ * path), then merges it independently. Threads get at least 65536
+ * elements each, smaller arrays are sorted by gMergeSort.
+ *
+ * The result is the same as gMergeSort's, the sort is stable. It uses
+ * one scratch buffer of n elements.
+ *
+ * @param arr:	Array being sorted
+ * @param n:	Length of the array
+ * @param elem_sz:	Size of each element in the array
+ * @param cmpfunc:	Function for comparing the elements, called
+ *			concurrently from several threads
+ * @param nthreads:	Number of threads, 0 for one per online processor
+ *
+ * @return	Pointer to the sorted array
+ *		Always equal to the input on success
+ *		NULL if the scratch buffer could not be allocated
+ *		(G_ENOMEN), the array is then left unchanged
+ */
+extern void *gParallelMergeSort(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,unsigned int nthreads);
 /** @} */
 #endif
 
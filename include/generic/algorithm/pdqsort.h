@@ -0,0 +1,77 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+/**
+ * @file	pdqsort.h
+ *
+ * @brief	Pattern-defeating quicksort, an in-place unstable sort
+ */
+#ifndef	ALGORITHM_PDQSORT_H
+#define	ALGORITHM_PDQSORT_H
+#include <stddef.h>	// size_t
+#include <generic/algorithm.h>
+/** @defgroup pdqsort Pattern-defeating Quicksort
+ *
+ * Pattern-defeating quicksort is a quicksort by Orson Peters that keeps
+ * the average speed of quicksort while defeating the inputs that make it
+ * slow:
+ * - the pivot is the median of 3, or a ninther on large ranges;
+ * - elements are compared against the pivot in blocks and the results
+ *   stored as offsets, without branching on them, then swapped in bulk;
+ * - runs of elements equal to the previous pivot are partitioned out at once;
+ * - a partition that did not move anything is finished with an insertion
+ *   sort that gives up after a few moves, which sorts presorted input in
+ *   linear time;
+ * - unbalanced partitions shuffle a few elements to break patterns, and
+ *   too many of them switch to heapsort, bounding the worst case to
+ *   O(n log n).
+ *
+ * Elements are swapped a machine word at a time. Only one element of
+ * temporary storage is used, on the stack unless elements are large.
+ *
+ * @see https://github.com/orlp/pdqsort
+ *
+ * @{
+ */
+
+/** @brief Pattern-defeating quicksort for generic types
+ *
+ * Equal elements may not keep their order, use gMergeSort for a stable
+ * sort.
+ *
+ * @param base:	Array being sorted
+ * @param n:	Length of the array
+ * @param elem_sz:	Size of each element in the array
+ * @param cmpfunc:	Function for comparing the elements
+ *
+ * @return	Pointer to the sorted array
+ *		Always equal to the input on success
+ *		NULL if an element larger than GSORT_STACK_ELEM could not
+ *		be allocated (G_ENOMEN), the array is then left unchanged
+ */
+extern void *gSort(void *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc);
+
+/** @brief Largest element using stack storage as temporary */
+#define	GSORT_STACK_ELEM	256
+/** @} */
+#endif
@@ -0,0 +1,121 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+/**
+ * @file	radixsort.h
+ *
+ * @brief	LSD radix sorts for integer and floating point keys
+ */
+#ifndef	ALGORITHM_RADIX_SORT_H
+#define	ALGORITHM_RADIX_SORT_H
+#include <stddef.h>	// size_t
+#include <stdint.h>
+#include <generic/algorithm.h>
+/** @defgroup radixsort Radix Sort
+ *
+ * Least significant digit radix sorts. Keys are not compared: every pass
+ * counts the keys per digit value and moves them to their bucket, from
+ * the lowest digit to the highest, keeping the order of the previous pass.
+ *
+ * 32 bit keys take three passes of 11 bit digits and 64 bit keys eight
+ * passes of 8 bit digits. The histograms of all passes are taken in one
+ * read of the input, and a pass where every key has the same digit is
+ * skipped. Keys are moved through a small buffer per bucket, written to
+ * the destination a cache line at a time.
+ *
+ * Signed and floating point keys are mapped to unsigned keys with the
+ * same order before sorting, and back after. Floats sort as -NaN, -inf,
+ * negative numbers, -0, +0, positive numbers, +inf, +NaN.
+ *
+ * Every sort is stable and takes O(n) time and O(n) extra memory. They
+ * return NULL and set gErrorCode to G_ENOMEN, leaving the array unchanged,
+ * if that memory could not be allocated.
+ *
+ * @see https://en.wikipedia.org/wiki/Radix_sort
+ *
+ * @{
+ */
+
+/** @brief Record keys are signed integers */
+#define	G_RADIX_SIGNED	1
+
+/** @brief Radix Sort for unsigned 32 bit integers
+ *
+ * @param arr:	Array being sorted
+ * @param n:	Length of the array
+ *
+ * @return	Pointer to the sorted array
+ *		Always equal to the input on success
+ *		NULL on failure
+ */
+extern uint32_t *gRadixSortU32(uint32_t *arr,size_t n);
+
+/** @brief Radix Sort for signed 32 bit integers
+ *
+ * @see gRadixSortU32
+ */
+extern int32_t *gRadixSortI32(int32_t *arr,size_t n);
+
+/** @brief Radix Sort for unsigned 64 bit integers
+ *
+ * @see gRadixSortU32
+ */
+extern uint64_t *gRadixSortU64(uint64_t *arr,size_t n);
+
+/** @brief Radix Sort for signed 64 bit integers
+ *
+ * @see gRadixSortU32
+ */
+extern int64_t *gRadixSortI64(int64_t *arr,size_t n);
+
+/** @brief Radix Sort for floats
+ *
+ * @see gRadixSortU32
+ */
+extern float *gRadixSortFloat(float *arr,size_t n);
+
+/** @brief Radix Sort for doubles
+ *
+ * @see gRadixSortU32
+ */
+extern double *gRadixSortDouble(double *arr,size_t n);
+
+/** @brief Radix Sort for records keyed by an integer field
+ *
+ * Records are moved whole, one 8 bit digit of the key per pass.
+ *
+ * @param base:	Array being sorted
+ * @param n:	Length of the array
+ * @param elem_sz:	Size of each record
+ * @param key_offset:	Offset of the key in a record
+ * @param key_width:	Size of the key, 1, 2, 4 or 8 bytes, in host byte order
+ * @param flags:	G_RADIX_SIGNED for signed keys, 0 otherwise
+ *
+ * @return	Pointer to the sorted array
+ *		Always equal to the input on success
+ *		NULL on failure, G_EINVAL if the key does not fit
+ *		in a record or has another width
+ */
+extern void *gRadixSortRecords(void *base,size_t n,size_t elem_sz,size_t key_offset,size_t key_width,int flags);
+/** @} */
+#endif
@@ -0,0 +1,128 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+/**
+ * @file	select.h
+ *
+ * @brief	Selecting the k-th or the k smallest or largest elements
+ */
+#ifndef	ALGORITHM_SELECT_H
+#define	ALGORITHM_SELECT_H
+#include <stddef.h>	// size_t
+#include <generic/algorithm.h>
+/** @defgroup select Selection
+ *
+ * gNthElement is introselect: a quickselect that partitions around the
+ * median of 3, or a ninther on large ranges, and only keeps the side
+ * holding the wanted position, O(n) on average. When the partitions keep
+ * being unbalanced it switches to a heap selection, so the worst case is
+ * O(n log n).
+ *
+ * gPartialSort selects then sorts the first k elements with gSort, in
+ * O(n + k log k). gTopK keeps the k largest elements of a stream in a
+ * min-heap of k elements, each new element costing one comparison unless
+ * it enters the heap.
+ *
+ * @see https://en.wikipedia.org/wiki/Introselect
+ *
+ * @{
+ */
+
+/** @brief Puts the n-th smallest element at its sorted position
+ *
+ * Elements before it are not greater and elements after it are not
+ * less, in no particular order.
+ *
+ * @param arr:	Array being partitioned
+ * @param n:	Length of the array
+ * @param elem_sz:	Size of each element in the array
+ * @param cmpfunc:	Function for comparing the elements
+ * @param nth:	Position wanted, nothing is done if not less than n
+ *
+ * @return	Pointer to the array
+ */
+extern void *gNthElement(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,size_t nth);
+
+/** @brief Sorts the k smallest elements at the front of an array
+ *
+ * The other elements are left after them in no particular order.
+ *
+ * @param k:	Number of elements sorted, the whole array if not less than n
+ *
+ * @return	Pointer to the array
+ *		NULL if gSort failed (G_ENOMEN)
+ *
+ * @see	gNthElement
+ */
+extern void *gPartialSort(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,size_t k);
+
+/** @brief The k largest elements seen in a stream
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gTopK{
+	/** @brief Min-heap of the kept elements */
+	char *heap;
+	/** @brief Number of elements kept */
+	size_t n;
+	/** @brief Most elements kept */
+	size_t k;
+	size_t elem_sz;
+	cmpfunc_t cmpfunc;
+}gTopK;
+
+/** @brief Creates an empty top-k
+ *
+ * @param elem_sz:	Size of each element
+ * @param k:	Number of elements kept, at least 1
+ * @param cmpfunc:	Function for comparing the elements, the largest
+ *			ones are kept
+ *
+ * @return	Pointer to the new top-k
+ *		NULL in case of allocation failure (G_ENOMEN) or if k is 0
+ *		(G_EINVAL)
+ */
+extern gTopK *gTopKCreate(size_t elem_sz,size_t k,cmpfunc_t cmpfunc);
+
+/** @brief Frees a top-k
+ */
+extern void gTopKDelete(gTopK *top);
+
+/** @brief Feeds a batch of elements to a top-k
+ *
+ * @param elems:	The elements
+ * @param n:	Number of elements
+ */
+extern void gTopKAddBatch(gTopK *top,const void *elems,size_t n);
+
+/** @brief Copies the kept elements, largest first
+ *
+ * The top-k is left as it is and can be fed more elements.
+ *
+ * @param out:	Room for top->k elements
+ *
+ * @return	Number of elements copied, less than k if fewer were fed
+ */
+extern size_t gTopKResult(gTopK *top,void *out);
+/** @} */
+#endif
@@ -0,0 +1,71 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+/**
+ * @file	timsort.h
+ *
+ * @brief	Adaptive stable merge sort taking advantage of existing order
+ */
+#ifndef	ALGORITHM_TIMSORT_H
+#define	ALGORITHM_TIMSORT_H
+#include <stddef.h>	// size_t
+#include <generic/algorithm.h>
+/** @defgroup timsort Timsort
+ *
+ * Timsort, written by Tim Peters for Python, is a merge sort of the runs
+ * already present in the input. Ascending runs and strictly descending
+ * runs, which are reversed, are found in one scan; runs shorter than a
+ * minimum of 32 to 64 elements are extended by binary insertion.
+ *
+ * Runs are pushed on a stack and merged while their lengths break
+ * invariants that keep the merges balanced, using the corrected checks of
+ * de Gouw et al., 2015: the original ones could leave the stack too deep.
+ * Merges start by skipping the elements of either run already in place,
+ * and switch to galloping, exponential then binary search, when one run
+ * keeps winning.
+ *
+ * Sorted or reverse sorted input takes n-1 comparisons and no moves
+ * beyond the reversal, random input O(n log n) comparisons.
+ *
+ * @see https://github.com/python/cpython/blob/main/Objects/listsort.txt
+ *
+ * @{
+ */
+
+/** @brief Timsort for generic types
+ *
+ * The sort is stable.
+ *
+ * @param arr:	Array being sorted
+ * @param n:	Length of the array
+ * @param elem_sz:	Size of each element in the array
+ * @param cmpfunc:	Function for comparing the elements
+ *
+ * @return	Pointer to the sorted array
+ *		Always equal to the input on success
+ *		NULL if the scratch buffer of n/2 elements could not be
+ *		allocated (G_ENOMEN), the array is then left unchanged
+ */
+extern void *gTimSort(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc);
+/** @} */
+#endif
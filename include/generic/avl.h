@@ -64,10 +64,14 @@ typedef struct avl_node {
 
 } avl_node_t;
 
+struct gBloom;
+
 typedef struct {
     avl_node_t *root;
     gDataCompare isGreater;
     size_t elementSize;
+    /** @brief Optional filter checked before every search, see gAVLAttachFilter */
+    struct gBloom *filter;
 } gAVL;
 
 /**
@@ -119,6 +123,25 @@ void gAVLDelete(gAVL *avl_tree);
  */
 avl_node_t *gAVLSearch(gAVL *avl_tree, void *data);
 
+/**
+ * Function: gAVLAttachFilter
+ * --------------------------
+ * Put a Bloom filter in front of the tree. The items already in the tree
+ * are added to it, so will be every item added later, and searches for
+ * items the filter has never seen return NULL without walking the tree.
+ *
+ * The filter is not owned by the tree, it must outlive it or be detached
+ * by attaching NULL.
+ *
+ * @param avl_tree  The avl_tree
+ * @param filter    A filter created with the elementSize of the tree,
+ *                  NULL to detach the current one
+ *
+ * @return      status code of operation
+ *              (0) if success, error code in case of failure.
+ */
+int gAVLAttachFilter(gAVL *avl_tree, struct gBloom *filter);
+
 /**
  * Function: gAVLheight
  * --------------------
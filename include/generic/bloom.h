@@ -0,0 +1,171 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	bloom.h
+ *
+ * @brief	Blocked Bloom filter over fixed size keys.
+ *
+ * A Bloom filter answers "was this key added?" with no false negatives and a
+ * configurable rate of false positives, using a few bits per key. In this
+ * blocked variant all the bits of a key fall in a single 64 byte block, so a
+ * lookup costs one cache miss whatever the number of hash functions. This
+ * raises the false positive rate slightly above the one of a classic filter
+ * of the same size.
+ *
+ * Keys are hashed with gHashBytes, two keys are the same key if their bytes
+ * are equal. A filter can be attached to a @ref bst.h or @ref avl.h tree to
+ * answer most searches for missing items without walking the tree.
+ */
+
+#ifndef LIBGENERIC_BLOOM_H
+#define LIBGENERIC_BLOOM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <generic.h>
+
+/** @brief Number of 64 bit words in a block, one cache line */
+#define	BLOOM_BLOCK_WORDS	8
+
+/** @brief The structure of Bloom filter
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gBloom {
+    /** @brief nblocks * BLOOM_BLOCK_WORDS words of bits */
+    uint64_t *bits;
+    size_t nblocks;
+    /** @brief Number of bits set per key */
+    unsigned int k;
+    size_t keySize;
+    /** @brief Number of keys added */
+    size_t count;
+} gBloom;
+
+/**
+ * Function: gBloomCreate
+ * ----------------------
+ * Create an empty filter sized for a number of keys and a false positive rate
+ *
+ * @param keySize       The size of the keys
+ * @param expected      Number of keys expected to be added
+ * @param fpRate        Wanted false positive rate once expected keys
+ *                      are added, between 0 and 1 exclusive
+ *
+ * @return              Pointer to the new filter
+ *                      will return NULL in case of failure
+ */
+gBloom *gBloomCreate(size_t keySize, size_t expected, double fpRate);
+
+/**
+ * Function: gBloomDelete
+ * ----------------------
+ * Delete a filter and free associated memories
+ *
+ * @param bloom     Filter that's being deleted.
+ */
+void gBloomDelete(gBloom *bloom);
+
+/**
+ * Function: gBloomAdd
+ * -------------------
+ * Add a key to the filter
+ *
+ * @param bloom     The filter
+ * @param key       The key to be added
+ */
+void gBloomAdd(gBloom *bloom, void *key);
+
+/**
+ * Function: gBloomContains
+ * ------------------------
+ * Check whether a key may have been added
+ *
+ * @param bloom     The filter
+ * @param key       The key to be checked
+ *
+ * @return          (0) if the key was never added,
+ *                  (1) if it probably was.
+ */
+int gBloomContains(gBloom *bloom, void *key);
+
+/**
+ * Function: gBloomAddBatch
+ * ------------------------
+ * Add an array of keys, hashing them together and prefetching
+ * their blocks ahead of the updates.
+ *
+ * @param bloom     The filter
+ * @param keys      The keys, stored contiguously
+ * @param n         Number of keys
+ */
+void gBloomAddBatch(gBloom *bloom, void *keys, size_t n);
+
+/**
+ * Function: gBloomContainsBatch
+ * -----------------------------
+ * Check an array of keys, out[i] = gBloomContains(key i)
+ *
+ * @param bloom     The filter
+ * @param keys      The keys, stored contiguously
+ * @param n         Number of keys
+ * @param out       Receives the n results
+ *
+ * @return          Number of keys that may have been added
+ */
+size_t gBloomContainsBatch(gBloom *bloom, void *keys, size_t n, unsigned char *out);
+
+/**
+ * Function: gBloomSerialize
+ * -------------------------
+ * Write the filter to a buffer in a portable format. Call with a NULL
+ * buffer to get the needed size.
+ *
+ * @param bloom     The filter
+ * @param buf       Destination buffer, may be NULL
+ * @param size      Size of buf
+ *
+ * @return          Number of bytes needed. Nothing is written if
+ *                  it is larger than size.
+ */
+size_t gBloomSerialize(gBloom *bloom, void *buf, size_t size);
+
+/**
+ * Function: gBloomDeserialize
+ * ---------------------------
+ * Create a filter from a buffer written by gBloomSerialize
+ *
+ * @param buf       The serialized filter
+ * @param size      Size of buf
+ *
+ * @return          Pointer to the new filter
+ *                  will return NULL if buf is not a valid filter (G_EINVAL)
+ *                  or in case of allocation failure.
+ */
+gBloom *gBloomDeserialize(const void *buf, size_t size);
+
+#endif //LIBGENERIC_BLOOM_H
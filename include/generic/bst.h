@@ -58,10 +58,14 @@ typedef struct bnode {
 	struct bnode *right;
 } bnode_t;
 
+struct gBloom;
+
 typedef struct gBST{
     bnode_t *root;
     gDataCompare isGreater;
     size_t elementSize;
+    /** @brief Optional filter checked before every search, see gBSTAttachFilter */
+    struct gBloom *filter;
 } gBST;
 
 /**
@@ -113,6 +117,25 @@ void gBSTDelete(gBST *bst);
  */
 bnode_t *gBSTSearch(gBST *bst, void *data);
 
+/**
+ * Function: gBSTAttachFilter
+ * --------------------------
+ * Put a Bloom filter in front of the tree. The items already in the tree
+ * are added to it, so will be every item added later, and searches for
+ * items the filter has never seen return NULL without walking the tree.
+ *
+ * The filter is not owned by the tree, it must outlive it or be detached
+ * by attaching NULL.
+ *
+ * @param bst       The bst
+ * @param filter    A filter created with the elementSize of the tree,
+ *                  NULL to detach the current one
+ *
+ * @return      status code of operation
+ *              (0) if success, error code in case of failure.
+ */
+int gBSTAttachFilter(gBST *bst, struct gBloom *filter);
+
 
 
 #endif
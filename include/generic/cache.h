@@ -0,0 +1,175 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	cache.h
+ *
+ * @brief	Bounded key/value cache with LRU or CLOCK eviction.
+ *
+ * Entries are found through a gHashMap from key to entry and live in a
+ * single array allocated up front, so lookups, insertions and evictions
+ * all take constant time and never allocate once the cache is created.
+ *
+ * G_CACHE_LRU keeps the entries in an intrusive dnode list ordered by last
+ * use and evicts the least recently used one; every hit moves its entry to
+ * the front. G_CACHE_CLOCK only sets a flag on a hit. To evict, a hand
+ * sweeps the entries in array order, clearing set flags, and takes the
+ * first entry whose flag was clear. Hits are cheaper and a key seen only
+ * once is evicted before keys seen again, at the price of evicting entries
+ * in an approximate LRU order.
+ */
+
+#ifndef LIBGENERIC_CACHE_H
+#define LIBGENERIC_CACHE_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <generic.h>
+#include <generic/hashmap.h>
+#include <generic/list.h>
+
+/** @brief Evict the least recently used entry */
+#define G_CACHE_LRU     0
+/** @brief Evict with the CLOCK second chance approximation of LRU */
+#define G_CACHE_CLOCK   1
+
+/**
+ * Called with the key and value of an entry evicted to make room for
+ * another one, before they are overwritten.
+ */
+typedef void (*gCacheEvict)(void *key, void *value, void *ctx);
+
+/** @brief The structure of cache
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gCache {
+    /** @brief capacity entries of slotSize bytes */
+    char *entries;
+    /** @brief Key to entry number */
+    gHashMap *index;
+    /** @brief Entries in use, most recently used first (LRU only) */
+    dnode order;
+    /** @brief Entries not in use */
+    dnode unused;
+    /** @brief Next entry looked at by the CLOCK hand */
+    size_t hand;
+    size_t capacity;
+    size_t size;
+    size_t keySize;
+    size_t valueSize;
+    size_t keyOffset;
+    size_t valueOffset;
+    size_t slotSize;
+    int policy;
+    gCacheEvict evict;
+    void *evictContext;
+    size_t hits;
+    size_t misses;
+} gCache;
+
+/**
+ * Function: gCacheCreate
+ * ----------------------
+ * Create an empty cache
+ *
+ * @param keySize       The size of the keys
+ * @param valueSize     The size of the values
+ * @param capacity      Maximum number of entries
+ * @param policy        G_CACHE_LRU or G_CACHE_CLOCK
+ * @param hash          Hash function for the keys,
+ *                      NULL to use gHashBytes
+ * @param equal         Compare function for the keys,
+ *                      NULL to compare the bytes of the keys
+ *
+ * @return              Pointer to the new cache
+ *                      will return NULL in case of failure
+ */
+gCache *gCacheCreate(size_t keySize, size_t valueSize, size_t capacity, int policy,
+                     gHashFunc hash, cmpfunc_t equal);
+
+/**
+ * Function: gCacheDelete
+ * ----------------------
+ * Delete a cache and free associated memories. The evict callback is not
+ * called for the remaining entries.
+ *
+ * @param cache     Cache that's being deleted.
+ */
+void gCacheDelete(gCache *cache);
+
+/**
+ * Function: gCacheSetEvict
+ * ------------------------
+ * Set the function called when an entry is evicted
+ *
+ * @param cache     The cache
+ * @param evict     The callback, NULL for none
+ * @param ctx       Passed to the callback
+ */
+void gCacheSetEvict(gCache *cache, gCacheEvict evict, void *ctx);
+
+/**
+ * Function: gCacheGet
+ * -------------------
+ * Look up a key and mark its entry as used
+ *
+ * @param cache     The cache
+ * @param key       The key
+ *
+ * @return          Pointer to the value, valid until the next gCachePut
+ *                  or gCacheRemove. NULL if the key is not cached.
+ */
+void *gCacheGet(gCache *cache, void *key);
+
+/**
+ * Function: gCachePut
+ * -------------------
+ * Insert a key or replace its value, and mark its entry as used. When the
+ * cache is full an entry is evicted first.
+ *
+ * @param cache     The cache
+ * @param key       The key
+ * @param value     The value to be copied
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOMEN if the index could not grow.
+ */
+int gCachePut(gCache *cache, void *key, void *value);
+
+/**
+ * Function: gCacheRemove
+ * ----------------------
+ * Remove a key, without calling the evict callback
+ *
+ * @param cache     The cache
+ * @param key       The key
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOITM if the key is not cached.
+ */
+int gCacheRemove(gCache *cache, void *key);
+
+#endif //LIBGENERIC_CACHE_H
@@ -0,0 +1,220 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	concurrentmap.h
+ *
+ * @brief	Hash map safe to use from several threads at once.
+ *
+ * Keys are spread over a power of two number of shards by their hash. Each
+ * shard is an open addressing table with its own mutex, taken only by writers,
+ * and a sequence counter that writers make odd while they modify the shard.
+ * Readers take no lock: they copy the value out, then retry if the sequence
+ * counter moved in the meantime. Since readers can still be looking at a table
+ * after it has been grown, replaced tables are only freed with the map; they
+ * add up to less than the size of the current ones.
+ *
+ * Values are always copied in and out, no pointer into the map is handed out.
+ */
+
+#ifndef LIBGENERIC_CONCURRENTMAP_H
+#define LIBGENERIC_CONCURRENTMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <generic.h>
+#include <generic/hash.h>
+
+/** @brief Number of shards used when 0 is given at creation */
+#define	CONCURRENTMAP_DEFAULT_SHARDS	64
+
+/** @brief Largest number of shards, more is refused with G_EINVAL */
+#define	CONCURRENTMAP_MAX_SHARDS	65536
+
+struct gConcurrentMapShard;
+
+/** @brief The structure of concurrent hash map
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gConcurrentMap {
+    struct gConcurrentMapShard *shards;
+    /** @brief Number of shards, always a power of two */
+    size_t nshards;
+    /** @brief Right shift turning a hash into a shard index */
+    unsigned int shardShift;
+    size_t keySize;
+    size_t valueSize;
+    size_t valueOffset;
+    size_t slotSize;
+    gHashFunc hash;
+    cmpfunc_t equal;
+} gConcurrentMap;
+
+/**
+ * This type is used by gConcurrentMapUpsert to update a value.
+ * It runs with the shard locked, on a private copy of the value
+ * which is published once it returns.
+ *
+ * @param value     The value to be updated, uninitialized if the key
+ *                  was not present
+ * @param exists    (1) if the key was present, (0) if not
+ * @param ctx       User context given to gConcurrentMapUpsert
+ */
+typedef void (*gConcurrentUpdate)(void *value, int exists, void *ctx);
+
+/**
+ * This type is used by gConcurrentMapComputeIfAbsent to create
+ * a missing value. It runs with the shard locked.
+ *
+ * @param key       The key being inserted
+ * @param value     Receives the new value
+ * @param ctx       User context given to gConcurrentMapComputeIfAbsent
+ *
+ * @return          (0) to insert the value, anything else to leave
+ *                  the key absent.
+ */
+typedef int (*gConcurrentCompute)(void *key, void *value, void *ctx);
+
+/**
+ * Function: gConcurrentMapCreate
+ * ------------------------------
+ * Create an empty concurrent hash map
+ *
+ * @param keySize       The size of the keys
+ * @param valueSize     The size of the values
+ * @param nshards       Number of shards, rounded up to a power of two.
+ *                      0 for CONCURRENTMAP_DEFAULT_SHARDS, at most
+ *                      CONCURRENTMAP_MAX_SHARDS
+ * @param hash          Hash function for the keys, NULL to use gHashBytes
+ * @param equal         Compare function for the keys, only its result
+ *                      being 0 for equal keys is used.
+ *                      NULL to compare the bytes of the keys
+ *
+ * @return              Pointer to the new map
+ *                      will return NULL in case of failure
+ */
+gConcurrentMap *gConcurrentMapCreate(size_t keySize, size_t valueSize, size_t nshards,
+                                     gHashFunc hash, cmpfunc_t equal);
+
+/**
+ * Function: gConcurrentMapDelete
+ * ------------------------------
+ * Delete a map. No other thread may be using it.
+ *
+ * @param map   The map being deleted
+ */
+void gConcurrentMapDelete(gConcurrentMap *map);
+
+/**
+ * Function: gConcurrentMapGet
+ * ---------------------------
+ * Copy out the value stored for a key, without taking any lock
+ *
+ * @param map       The map to be searched
+ * @param key       The key to be searched
+ * @param value     Receives a copy of the value, may be NULL
+ *
+ * @return          (1) if found, (0) if not
+ */
+int gConcurrentMapGet(gConcurrentMap *map, void *key, void *value);
+
+/**
+ * Function: gConcurrentMapPut
+ * ---------------------------
+ * Insert a key with its value, replacing the value if the key
+ * is already present.
+ *
+ * @param map   The map where the entry is to be stored
+ * @param key   The key
+ * @param value The value
+ *
+ * @return      status code of operation
+ *              (0) if success, error code in case of failure.
+ */
+int gConcurrentMapPut(gConcurrentMap *map, void *key, void *value);
+
+/**
+ * Function: gConcurrentMapRemove
+ * ------------------------------
+ * Remove a key and its value
+ *
+ * @param map   The map from which the key is to be removed
+ * @param key   The key to be removed
+ *
+ * @return      status code of operation
+ *              (0) if success, G_ENOITM if the key was not present.
+ */
+int gConcurrentMapRemove(gConcurrentMap *map, void *key);
+
+/**
+ * Function: gConcurrentMapUpsert
+ * ------------------------------
+ * Atomically insert or update the value of a key
+ *
+ * @param map       The map
+ * @param key       The key to be inserted or updated
+ * @param update    Computes the new value from the old one
+ * @param ctx       Passed unchanged to update
+ *
+ * @return          status code of operation
+ *                  (0) if success, error code in case of failure.
+ */
+int gConcurrentMapUpsert(gConcurrentMap *map, void *key, gConcurrentUpdate update, void *ctx);
+
+/**
+ * Function: gConcurrentMapComputeIfAbsent
+ * ---------------------------------------
+ * Return the value of a key, atomically creating it if it is missing.
+ * compute is called at most once per key, whatever the number of
+ * threads racing on it.
+ *
+ * @param map       The map
+ * @param key       The key
+ * @param compute   Creates the value when the key is not present
+ * @param ctx       Passed unchanged to compute
+ * @param value     Receives a copy of the existing or new value, may be NULL
+ *
+ * @return          status code of operation
+ *                  (0) if the key is present when returning,
+ *                  G_ENOITM if compute declined to create it,
+ *                  error code in case of failure.
+ */
+int gConcurrentMapComputeIfAbsent(gConcurrentMap *map, void *key, gConcurrentCompute compute,
+                                  void *ctx, void *value);
+
+/**
+ * Function: gConcurrentMapSize
+ * ----------------------------
+ * Number of entries. Only exact if no other thread is modifying the map.
+ *
+ * @param map   The map
+ *
+ * @return      Number of entries
+ */
+size_t gConcurrentMapSize(gConcurrentMap *map);
+
+#endif //LIBGENERIC_CONCURRENTMAP_H
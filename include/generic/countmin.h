@@ -0,0 +1,199 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	countmin.h
+ *
+ * @brief	Count-Min sketch, estimates how many times each key was added.
+ *
+ * depth rows of width counters; a key increments one counter per row and
+ * its estimate is the smallest of them. Estimates are never below the real
+ * count and exceed it by at most epsilon times the total count, with
+ * probability 1 - delta. With conservative update a key only raises the
+ * counters that are below its new estimate, which keeps the same guarantee
+ * and makes overestimates much smaller. Merged sketches still never
+ * underestimate, but lose that advantage for the counts merged.
+ *
+ * The sketch can also track the topK keys with the largest estimates, in
+ * a min-heap indexed by a gHashMap.
+ *
+ * Keys are hashed with gHashBytes.
+ */
+
+#ifndef LIBGENERIC_COUNTMIN_H
+#define LIBGENERIC_COUNTMIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <generic.h>
+#include <generic/hashmap.h>
+
+/** @brief The structure of Count-Min sketch
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gCountMin {
+    /** @brief depth rows of width counters */
+    uint32_t *counters;
+    /** @brief Counters per row, always a power of two */
+    size_t width;
+    size_t depth;
+    size_t keySize;
+    /** @brief Sum of all the counts added */
+    uint64_t total;
+    int conservative;
+    /** @brief Heavy hitters, a min-heap of (uint64_t count, key) entries */
+    char *heavy;
+    size_t heavySize;
+    size_t topK;
+    size_t heavyEntrySize;
+    /** @brief Key to position in the heap */
+    gHashMap *heavyIndex;
+} gCountMin;
+
+/**
+ * Function: gCountMinCreate
+ * -------------------------
+ * Create an empty sketch
+ *
+ * @param keySize       The size of the keys
+ * @param epsilon       Error bound, relative to the total count
+ * @param delta         Probability of exceeding the error bound
+ * @param conservative  Nonzero to use conservative update
+ * @param topK          Number of heavy hitters to track, may be 0
+ *
+ * @return              Pointer to the new sketch
+ *                      will return NULL in case of failure
+ */
+gCountMin *gCountMinCreate(size_t keySize, double epsilon, double delta, int conservative, size_t topK);
+
+/**
+ * Function: gCountMinDelete
+ * -------------------------
+ * Delete a sketch and free associated memories
+ *
+ * @param cms       Sketch that's being deleted.
+ */
+void gCountMinDelete(gCountMin *cms);
+
+/**
+ * Function: gCountMinAdd
+ * ----------------------
+ * Add count occurrences of a key
+ *
+ * @param cms       The sketch
+ * @param key       The key
+ * @param count     Number of occurrences
+ *
+ * @return          status code of operation
+ *                  (0) if success
+ */
+int gCountMinAdd(gCountMin *cms, void *key, uint32_t count);
+
+/**
+ * Function: gCountMinAddBatch
+ * ---------------------------
+ * Add one occurrence of each of n keys stored contiguously, hashing
+ * them in batches
+ *
+ * @param cms       The sketch
+ * @param keys      Array of n keys
+ * @param n         Number of keys
+ *
+ * @return          status code of operation
+ *                  (0) if success
+ */
+int gCountMinAddBatch(gCountMin *cms, void *keys, size_t n);
+
+/**
+ * Function: gCountMinEstimate
+ * ---------------------------
+ * @param cms       The sketch
+ * @param key       The key
+ *
+ * @return          Estimated number of occurrences of the key
+ */
+uint64_t gCountMinEstimate(gCountMin *cms, void *key);
+
+/**
+ * Function: gCountMinTopK
+ * -----------------------
+ * Get the tracked heavy hitters, largest estimate first
+ *
+ * @param cms       The sketch
+ * @param keys      Receives up to topK keys, keySize bytes each
+ * @param counts    Receives their estimates, may be NULL
+ *
+ * @return          Number of keys written, 0 with G_ENOMEN set if
+ *                  sorting them failed
+ */
+size_t gCountMinTopK(gCountMin *cms, void *keys, uint64_t *counts);
+
+/**
+ * Function: gCountMinMerge
+ * ------------------------
+ * Add the counts of another sketch to a sketch. The heavy hitters of src
+ * are offered to the heap of dst with their merged estimates.
+ *
+ * @param dst       The sketch being updated
+ * @param src       The sketch merged into dst, unchanged
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_EINVAL if the dimensions or key
+ *                  sizes differ.
+ */
+int gCountMinMerge(gCountMin *dst, gCountMin *src);
+
+/**
+ * Function: gCountMinSerialize
+ * ----------------------------
+ * Write the sketch and its heavy hitters to a buffer in a portable
+ * format. Call with a NULL buffer to get the needed size.
+ *
+ * @param cms       The sketch
+ * @param buf       Destination buffer, may be NULL
+ * @param size      Size of buf
+ *
+ * @return          Number of bytes needed. Nothing is written if
+ *                  it is larger than size.
+ */
+size_t gCountMinSerialize(gCountMin *cms, void *buf, size_t size);
+
+/**
+ * Function: gCountMinDeserialize
+ * ------------------------------
+ * Create a sketch from a buffer written by gCountMinSerialize
+ *
+ * @param buf       The serialized sketch
+ * @param size      Size of buf
+ *
+ * @return          Pointer to the new sketch
+ *                  will return NULL if buf is not a valid sketch (G_EINVAL)
+ *                  or in case of allocation failure.
+ */
+gCountMin *gCountMinDeserialize(const void *buf, size_t size);
+
+#endif //LIBGENERIC_COUNTMIN_H
@@ -0,0 +1,142 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	cuckoo.h
+ *
+ * @brief	Cuckoo filter, approximate set membership with removal.
+ *
+ * Like a Bloom filter it answers "was this key added?" with no false
+ * negatives and a small rate of false positives, but keys can also be
+ * removed. Each key is reduced to a short fingerprint stored in one of two
+ * buckets of 4 slots; a full bucket makes room by moving one of its
+ * fingerprints to its other bucket. A bucket is compared against a
+ * fingerprint in a single 64 bit word operation.
+ *
+ * With f bit fingerprints the false positive rate is about 8 / 2^f times
+ * the occupancy. Insertions start failing once about 95% of the slots are
+ * used, the slot count is rounded up to a power of two.
+ *
+ * Keys are hashed with gHashBytes, two keys are the same key if their
+ * bytes are equal.
+ */
+
+#ifndef LIBGENERIC_CUCKOO_H
+#define LIBGENERIC_CUCKOO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <generic.h>
+
+/** @brief Slots per bucket */
+#define	CUCKOO_BUCKET_SLOTS	4
+
+/** @brief The structure of cuckoo filter
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gCuckoo {
+    /** @brief Buckets of 4 fingerprints, bucketBytes each, packed */
+    unsigned char *buckets;
+    /** @brief Number of buckets, always a power of two */
+    size_t nbuckets;
+    /** @brief Bits per fingerprint: 8, 12 or 16 */
+    unsigned int fingerprintBits;
+    size_t bucketBytes;
+    size_t keySize;
+    /** @brief Number of keys stored */
+    size_t count;
+    /** @brief Fingerprint that could not be placed, 0 if none */
+    uint32_t victim;
+    size_t victimBucket;
+    uint64_t random;
+} gCuckoo;
+
+/**
+ * Function: gCuckooCreate
+ * -----------------------
+ * Create an empty filter
+ *
+ * @param keySize           The size of the keys
+ * @param capacity          Number of keys the filter should hold
+ * @param fingerprintBits   8, 12 or 16
+ *
+ * @return                  Pointer to the new filter
+ *                          will return NULL in case of failure
+ */
+gCuckoo *gCuckooCreate(size_t keySize, size_t capacity, unsigned int fingerprintBits);
+
+/**
+ * Function: gCuckooDelete
+ * -----------------------
+ * Delete a filter and free associated memories
+ *
+ * @param filter    Filter that's being deleted.
+ */
+void gCuckooDelete(gCuckoo *filter);
+
+/**
+ * Function: gCuckooAdd
+ * --------------------
+ * Add a key to the filter. Adding a key twice stores it twice,
+ * it then has to be removed twice.
+ *
+ * @param filter    The filter
+ * @param key       The key to be added
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_EFULL if the filter is full.
+ */
+int gCuckooAdd(gCuckoo *filter, void *key);
+
+/**
+ * Function: gCuckooContains
+ * -------------------------
+ * Check whether a key may have been added
+ *
+ * @param filter    The filter
+ * @param key       The key to be checked
+ *
+ * @return          (0) if the key is not in the filter,
+ *                  (1) if it probably is.
+ */
+int gCuckooContains(gCuckoo *filter, void *key);
+
+/**
+ * Function: gCuckooRemove
+ * -----------------------
+ * Remove a key from the filter. Only keys that were added may be removed,
+ * removing any other key may remove a key sharing its fingerprint.
+ *
+ * @param filter    The filter
+ * @param key       The key to be removed
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOITM if the key was not found.
+ */
+int gCuckooRemove(gCuckoo *filter, void *key);
+
+#endif //LIBGENERIC_CUCKOO_H
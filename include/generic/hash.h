@@ -0,0 +1,129 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file    hash.h
+ *
+ * @brief   Fast non-cryptographic hash functions.
+ *
+ * gHashBytes is a wyhash style 64 bit hash for keys of any length. Keys of 4
+ * and 8 bytes are hashed with a dedicated integer mixer instead, so that
+ * gHashBytes(&x, sizeof(x)) always equals gHashU32(x) or gHashU64(x), and
+ * 16 byte keys go through a branch free version of the wyhash short path.
+ * gHashBatch gives the same values as gHashBytes for a whole array of keys.
+ *
+ * None of these functions are meant to resist attackers choosing the keys.
+ */
+
+#ifndef _GENERIC_HASH_H_
+#define _GENERIC_HASH_H_
+
+#include <stddef.h>	// size_t
+#include <stdint.h>
+#include <generic.h>
+
+/**
+ * This type is used to implement hash functions used by the hash
+ * based containers. gHashBytes is one of them.
+ *
+ * Expected behaviour:
+ *      Should return the same value for equal keys, with
+ *      the bits as uniformly distributed as possible.
+ */
+typedef uint64_t (*gHashFunc)(const void *key, size_t keySize);
+
+/**
+ * Function: gHashBytes
+ * --------------------
+ * Hash a sequence of bytes
+ *
+ * @param key	    The bytes to hash
+ * @param len	    Number of bytes
+ *
+ * @return          64 bit hash
+ */
+uint64_t gHashBytes(const void *key, size_t len);
+
+/**
+ * Function: gHashBytesSeed
+ * ------------------------
+ * Hash a sequence of bytes with a seed, different seeds give
+ * unrelated hash functions. A seed of 0 gives gHashBytes.
+ *
+ * @param key	    The bytes to hash
+ * @param len	    Number of bytes
+ * @param seed	    The seed
+ *
+ * @return          64 bit hash
+ */
+uint64_t gHashBytesSeed(const void *key, size_t len, uint64_t seed);
+
+/**
+ * Function: gHashU32
+ * ------------------
+ * Hash a 4 byte key, a bijection of the 32 bit input.
+ *
+ * @param key	    The key
+ *
+ * @return          64 bit hash
+ */
+uint64_t gHashU32(uint32_t key);
+
+/**
+ * Function: gHashU64
+ * ------------------
+ * Hash an 8 byte key, a bijection of the 64 bit input.
+ *
+ * @param key	    The key
+ *
+ * @return          64 bit hash
+ */
+uint64_t gHashU64(uint64_t key);
+
+/**
+ * Function: gHash128
+ * ------------------
+ * Hash a 16 byte key
+ *
+ * @param key	    Pointer to the 16 bytes, no alignment needed
+ *
+ * @return          64 bit hash
+ */
+uint64_t gHash128(const void *key);
+
+/**
+ * Function: gHashBatch
+ * --------------------
+ * Hash an array of fixed size keys, out[i] = gHashBytes(key i, keySize).
+ * 4 and 8 byte keys are hashed several at a time with AVX2 when the
+ * processor supports it.
+ *
+ * @param keys	    The keys, stored contiguously
+ * @param n	        Number of keys
+ * @param keySize	Size of each key
+ * @param out	    Receives the n hashes
+ */
+void gHashBatch(const void *keys, size_t n, size_t keySize, uint64_t *out);
+
+#endif //_GENERIC_HASH_H_
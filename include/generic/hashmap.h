@@ -0,0 +1,186 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	hashmap.h
+ *
+ * @brief	Open addressing hash map with fixed size keys and values.
+ *
+ * Entries live in a single power of two sized array. Next to it, one control
+ * byte per slot stores whether the slot is empty or, for used slots, 7 bits of
+ * the hash of its key. Lookups compare 16 control bytes at once (with SSE2
+ * when available) and only call the equality function for slots whose control
+ * byte matches. Collisions are resolved by linear probing, which allows
+ * removals to shift the following entries back instead of leaving tombstones.
+ */
+
+#ifndef LIBGENERIC_HASHMAP_H
+#define LIBGENERIC_HASHMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <generic.h>
+#include <generic/hash.h>
+
+/** @brief Initial number of slots of a hash map */
+#define	HASHMAP_DEFAULT_SLOTS	16
+
+/** @brief The structure of hash map
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gHashMap {
+    /** @brief Control bytes, capacity plus a copy of the first group */
+    unsigned char *ctrl;
+    /** @brief Key/value pairs, slotSize bytes each */
+    char *slots;
+    /** @brief Number of slots, always a power of two */
+    size_t capacity;
+    /** @brief Number of stored entries */
+    size_t size;
+    size_t keySize;
+    size_t valueSize;
+    /** @brief Offset of the value inside a slot */
+    size_t valueOffset;
+    size_t slotSize;
+    gHashFunc hash;
+    cmpfunc_t equal;
+} gHashMap;
+
+/**
+ * Function: gHashMapCreate
+ * ------------------------
+ * Create an empty hash map
+ *
+ * @param keySize       The size of the keys
+ * @param valueSize     The size of the values, may be 0 to use the map as a set
+ * @param hash          Hash function for the keys,
+ *                      NULL to use gHashBytes
+ * @param equal         Compare function for the keys, only its result
+ *                      being 0 for equal keys is used.
+ *                      NULL to compare the bytes of the keys
+ *
+ * @return              Pointer to the new hash map
+ *                      will return NULL in case of failure
+ */
+gHashMap *gHashMapCreate(size_t keySize, size_t valueSize, gHashFunc hash, cmpfunc_t equal);
+
+/**
+ * Function: gHashMapDelete
+ * ------------------------
+ * Delete a hash map and free associated memories
+ *
+ * @param map   Hash map that's being deleted.
+ */
+void gHashMapDelete(gHashMap *map);
+
+/**
+ * Function: gHashMapPut
+ * ---------------------
+ * Insert a key with its value, replacing the value if the key
+ * is already present. Both are copied into the map.
+ *
+ * @param map   The map where the entry is to be stored
+ * @param key   The key
+ * @param value The value, ignored if valueSize is 0
+ *
+ * @return      status code of operation
+ *              (0) if success, error code in case of failure.
+ */
+int gHashMapPut(gHashMap *map, void *key, void *value);
+
+/**
+ * Function: gHashMapGet
+ * ---------------------
+ * Find the value stored for a key
+ *
+ * @param map   The map to be searched
+ * @param key   The key to be searched
+ *
+ * @return      Pointer to the stored value, NULL if the key is not present.
+ *              The pointer is invalidated by the next put or remove.
+ */
+void *gHashMapGet(gHashMap *map, void *key);
+
+/**
+ * Function: gHashMapContains
+ * --------------------------
+ * Check whether a key is present, also works for maps with valueSize 0
+ *
+ * @param map   The map to be searched
+ * @param key   The key to be searched
+ *
+ * @return      (1) if present, (0) if not.
+ */
+int gHashMapContains(gHashMap *map, void *key);
+
+/**
+ * Function: gHashMapRemove
+ * ------------------------
+ * Remove a key and its value
+ *
+ * @param map   The map from which the key is to be removed
+ * @param key   The key to be removed
+ *
+ * @return      status code of operation
+ *              (0) if success, G_ENOITM if the key was not present.
+ */
+int gHashMapRemove(gHashMap *map, void *key);
+
+/**
+ * Function: gHashMapReserve
+ * -------------------------
+ * Grow the map so that n entries fit without any further reallocation
+ *
+ * @param map   The map to be grown
+ * @param n     Number of entries
+ *
+ * @return      status code of operation
+ *              (0) if success, G_ENOMEN if n entries cannot be allocated.
+ */
+int gHashMapReserve(gHashMap *map, size_t n);
+
+/**
+ * Function: gHashMapIterate
+ * -------------------------
+ * Walk through the entries of the map, in no particular order.
+ * The map must not be modified during the walk.
+ *
+ *  size_t pos = 0;
+ *  void *key, *value;
+ *  while (gHashMapIterate(map, &pos, &key, &value) == 0) { ... }
+ *
+ * @param map   The map being walked
+ * @param pos   Position of the walk, must be 0 for the first call
+ * @param key   Set to the key of the next entry
+ * @param value Set to the value of the next entry, may be NULL
+ *
+ * @return      (0) if an entry was found, G_EITMEND at the end of the map,
+ *              G_EINVLD if map is NULL.
+ */
+int gHashMapIterate(gHashMap *map, size_t *pos, void **key, void **value);
+
+#endif //LIBGENERIC_HASHMAP_H
@@ -0,0 +1,173 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	heap.h
+ *
+ * @brief	Priority queue kept as an implicit heap in contiguous memory.
+ *
+ * Elements of a fixed size are stored in one array, like gVector, with
+ * the children of element i at d*i+1 ... d*i+d. The top is the smallest
+ * element for the compare function, give it reversed for a max-heap.
+ *
+ * The arity d is 2 or 4. A 4-ary heap is half as deep, so a push moves
+ * half as many elements, and the 4 children compared when sifting down
+ * are adjacent, usually in one or two cache lines. It tends to win once
+ * the heap outgrows the L1 cache.
+ *
+ * Sifting moves a hole instead of swapping, each level costs one copy.
+ */
+
+#ifndef LIBGENERIC_HEAP_H
+#define LIBGENERIC_HEAP_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <generic.h>
+
+/** @brief Default number of elements of a heap */
+#define	HEAP_DEFAULT_ELEMS	16
+
+/** @brief The structure of heap
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gHeap {
+    /** @brief The elements, in heap order */
+    char *elems;
+    /** @brief Room for one element, used while sifting */
+    char *hole;
+    size_t elemSize;
+    /** @brief Number of elements */
+    size_t n;
+    /** @brief Number of elements allocated */
+    size_t capacity;
+    /** @brief Children per node: 2 or 4 */
+    unsigned int arity;
+    cmpfunc_t compare;
+} gHeap;
+
+/**
+ * Function: gHeapCreate
+ * ---------------------
+ * Create an empty heap
+ *
+ * @param elemSize      The size of the elements
+ * @param arity         Children per node, 2 or 4
+ * @param compare       Orders the elements, the smallest is on top
+ *
+ * @return              Pointer to the new heap
+ *                      will return NULL in case of failure
+ */
+gHeap *gHeapCreate(size_t elemSize, unsigned int arity, cmpfunc_t compare);
+
+/**
+ * Function: gHeapDelete
+ * ---------------------
+ * Delete a heap and free associated memories
+ *
+ * @param heap      Heap that's being deleted.
+ */
+void gHeapDelete(gHeap *heap);
+
+/**
+ * Function: gHeapReserve
+ * ----------------------
+ * Make room for at least n elements
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOMEN on allocation failure.
+ */
+int gHeapReserve(gHeap *heap, size_t n);
+
+/**
+ * Function: gHeapPush
+ * -------------------
+ * Add an element, O(log n)
+ *
+ * @param heap      The heap
+ * @param elem      The element to be added
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOMEN if the heap could not grow.
+ */
+int gHeapPush(gHeap *heap, const void *elem);
+
+/**
+ * Function: gHeapHeapify
+ * ----------------------
+ * Add n elements at once. They are appended, then the heap is rebuilt
+ * bottom-up in O(size) time, which is cheaper than n pushes once n is
+ * more than a small part of the heap.
+ *
+ * @param heap      The heap
+ * @param elems     Array of n elements
+ * @param n         Number of elements
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOMEN if the heap could not grow.
+ */
+int gHeapHeapify(gHeap *heap, const void *elems, size_t n);
+
+/**
+ * Function: gHeapTop
+ * ------------------
+ * The smallest element
+ *
+ * @return          Pointer to the element, valid until the heap changes.
+ *                  NULL if the heap is empty.
+ */
+void *gHeapTop(gHeap *heap);
+
+/**
+ * Function: gHeapPop
+ * ------------------
+ * Remove the smallest element, O(log n)
+ *
+ * @param heap      The heap
+ * @param out       Receives the element, may be NULL
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOITM if the heap is empty.
+ */
+int gHeapPop(gHeap *heap, void *out);
+
+/**
+ * Function: gHeapReplaceTop
+ * -------------------------
+ * Remove the smallest element and add another, with a single sift down.
+ * Cheaper than a pop followed by a push, e.g. to keep the k largest
+ * elements of a stream or to advance the head of a merged input.
+ *
+ * @param heap      The heap
+ * @param elem      The element to be added
+ * @param out       Receives the removed element, may be NULL
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOITM if the heap is empty.
+ */
+int gHeapReplaceTop(gHeap *heap, const void *elem, void *out);
+
+#endif //LIBGENERIC_HEAP_H
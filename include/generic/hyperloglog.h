@@ -0,0 +1,178 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	hyperloglog.h
+ *
+ * @brief	HyperLogLog, estimates the number of distinct keys added.
+ *
+ * With 2^p registers the estimate has a relative standard error of about
+ * 1.04 / sqrt(2^p), whatever the number of keys: 1.6% for p = 12 in 4 KB.
+ *
+ * A sketch starts sparse, as a list of the few registers that are set, and
+ * switches to one byte per register once that list would be larger. The
+ * estimate uses Ertl's improved estimator, which needs no bias correction
+ * tables at small or large cardinalities.
+ *
+ * Two sketches with the same precision can be merged, the result is the
+ * sketch of the union of their keys. Keys are hashed with gHashBytes.
+ */
+
+#ifndef LIBGENERIC_HYPERLOGLOG_H
+#define LIBGENERIC_HYPERLOGLOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <generic.h>
+
+/** @brief Smallest precision */
+#define HLL_MIN_PRECISION   4
+/** @brief Largest precision */
+#define HLL_MAX_PRECISION   18
+
+/** @brief The structure of HyperLogLog sketch
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gHLL {
+    /** @brief One byte per register, NULL while the sketch is sparse */
+    unsigned char *registers;
+    /** @brief Set registers as (index << 8 | value), while sparse.
+     * The first sparseSorted entries are sorted by index and unique. */
+    uint32_t *sparse;
+    size_t sparseSize;
+    size_t sparseSorted;
+    size_t sparseCapacity;
+    /** @brief Registers are 2^precision */
+    unsigned int precision;
+    size_t keySize;
+} gHLL;
+
+/**
+ * Function: gHLLCreate
+ * --------------------
+ * Create an empty sketch
+ *
+ * @param keySize       The size of the keys
+ * @param precision     Log2 of the number of registers,
+ *                      from HLL_MIN_PRECISION to HLL_MAX_PRECISION
+ *
+ * @return              Pointer to the new sketch
+ *                      will return NULL in case of failure
+ */
+gHLL *gHLLCreate(size_t keySize, unsigned int precision);
+
+/**
+ * Function: gHLLDelete
+ * --------------------
+ * Delete a sketch and free associated memories
+ *
+ * @param hll       Sketch that's being deleted.
+ */
+void gHLLDelete(gHLL *hll);
+
+/**
+ * Function: gHLLAdd
+ * -----------------
+ * Add a key to the sketch
+ *
+ * @param hll       The sketch
+ * @param key       The key to be added
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOMEN if the sketch could not grow.
+ */
+int gHLLAdd(gHLL *hll, void *key);
+
+/**
+ * Function: gHLLAddBatch
+ * ----------------------
+ * Add n keys stored contiguously, hashing them in batches
+ *
+ * @param hll       The sketch
+ * @param keys      Array of n keys
+ * @param n         Number of keys
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOMEN if the sketch could not grow.
+ */
+int gHLLAddBatch(gHLL *hll, void *keys, size_t n);
+
+/**
+ * Function: gHLLCount
+ * -------------------
+ * Estimate the number of distinct keys added
+ *
+ * @param hll       The sketch
+ *
+ * @return          The estimate
+ */
+double gHLLCount(gHLL *hll);
+
+/**
+ * Function: gHLLMerge
+ * -------------------
+ * Add the keys of another sketch to a sketch
+ *
+ * @param dst       The sketch being updated
+ * @param src       The sketch merged into dst, unchanged
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_EINVAL if the precisions or key
+ *                  sizes differ.
+ */
+int gHLLMerge(gHLL *dst, gHLL *src);
+
+/**
+ * Function: gHLLSerialize
+ * -----------------------
+ * Write the sketch to a buffer in a portable format, sparse sketches stay
+ * sparse. Call with a NULL buffer to get the needed size.
+ *
+ * @param hll       The sketch
+ * @param buf       Destination buffer, may be NULL
+ * @param size      Size of buf
+ *
+ * @return          Number of bytes needed. Nothing is written if
+ *                  it is larger than size.
+ */
+size_t gHLLSerialize(gHLL *hll, void *buf, size_t size);
+
+/**
+ * Function: gHLLDeserialize
+ * -------------------------
+ * Create a sketch from a buffer written by gHLLSerialize
+ *
+ * @param buf       The serialized sketch
+ * @param size      Size of buf
+ *
+ * @return          Pointer to the new sketch
+ *                  will return NULL if buf is not a valid sketch (G_EINVAL)
+ *                  or in case of allocation failure.
+ */
+gHLL *gHLLDeserialize(const void *buf, size_t size);
+
+#endif //LIBGENERIC_HYPERLOGLOG_H
@@ -0,0 +1,202 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	indexedheap.h
+ *
+ * @brief	Priority queue whose entries can be changed or removed by handle.
+ *
+ * Every element pushed gets a handle that stays valid until the element
+ * is popped or removed, whatever else happens to the heap. Through it the
+ * element can be read, have its key lowered or raised, or be removed, in
+ * O(log n), as Dijkstra's and A*'s decrease-key or rescheduling a timer
+ * need. Handles are small integers, freed ones are reused.
+ *
+ * The elements are kept in heap order in one array, with 4 children per
+ * node like a 4-ary gHeap, and two arrays map handles to positions and
+ * back. The top is the smallest element for the compare function.
+ */
+
+#ifndef LIBGENERIC_INDEXEDHEAP_H
+#define LIBGENERIC_INDEXEDHEAP_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <generic.h>
+
+/** @brief Children per node */
+#define	INDEXED_HEAP_ARITY	4
+
+/** @brief Position of a handle that is not in use */
+#define	INDEXED_HEAP_NONE	((size_t) -1)
+
+/** @brief The structure of indexed heap
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gIndexedHeap {
+    /** @brief The elements, in heap order */
+    char *elems;
+    /** @brief Handle of the element at each position */
+    size_t *handles;
+    /** @brief Position of the element of each handle, or INDEXED_HEAP_NONE */
+    size_t *positions;
+    /** @brief Handles given back, reused first */
+    size_t *freeHandles;
+    size_t freeCount;
+    /** @brief Room for one element, used while sifting */
+    char *hole;
+    size_t elemSize;
+    /** @brief Number of elements */
+    size_t n;
+    /** @brief Number of elements and handles allocated */
+    size_t capacity;
+    cmpfunc_t compare;
+} gIndexedHeap;
+
+/**
+ * Function: gIndexedHeapCreate
+ * ----------------------------
+ * Create an empty indexed heap
+ *
+ * @param elemSize      The size of the elements
+ * @param compare       Orders the elements, the smallest is on top
+ *
+ * @return              Pointer to the new heap
+ *                      will return NULL in case of failure
+ */
+gIndexedHeap *gIndexedHeapCreate(size_t elemSize, cmpfunc_t compare);
+
+/**
+ * Function: gIndexedHeapDelete
+ * ----------------------------
+ * Delete a heap and free associated memories
+ *
+ * @param heap      Heap that's being deleted.
+ */
+void gIndexedHeapDelete(gIndexedHeap *heap);
+
+/**
+ * Function: gIndexedHeapPush
+ * --------------------------
+ * Add an element, O(log n)
+ *
+ * @param heap      The heap
+ * @param elem      The element to be added
+ * @param handle    Receives the handle of the element, may be NULL
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOMEN if the heap could not grow.
+ */
+int gIndexedHeapPush(gIndexedHeap *heap, const void *elem, size_t *handle);
+
+/**
+ * Function: gIndexedHeapTop
+ * -------------------------
+ * The smallest element
+ *
+ * @param heap      The heap
+ * @param handle    Receives its handle, may be NULL
+ *
+ * @return          Pointer to the element, valid until the heap changes.
+ *                  NULL if the heap is empty.
+ */
+void *gIndexedHeapTop(gIndexedHeap *heap, size_t *handle);
+
+/**
+ * Function: gIndexedHeapPop
+ * -------------------------
+ * Remove the smallest element, its handle is freed
+ *
+ * @param heap      The heap
+ * @param out       Receives the element, may be NULL
+ * @param handle    Receives its handle, may be NULL
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOITM if the heap is empty.
+ */
+int gIndexedHeapPop(gIndexedHeap *heap, void *out, size_t *handle);
+
+/**
+ * Function: gIndexedHeapGet
+ * -------------------------
+ * The element of a handle
+ *
+ * @return          Pointer to the element, valid until the heap changes.
+ *                  NULL if the handle is not in use.
+ */
+void *gIndexedHeapGet(gIndexedHeap *heap, size_t handle);
+
+/**
+ * Function: gIndexedHeapDecreaseKey
+ * ---------------------------------
+ * Replace the element of a handle by one that is not larger, O(log n)
+ *
+ * @param heap      The heap
+ * @param handle    Handle of the element
+ * @param elem      The new element
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOITM if the handle is not in use,
+ *                  G_EINVAL if elem is larger than the element it replaces.
+ */
+int gIndexedHeapDecreaseKey(gIndexedHeap *heap, size_t handle, const void *elem);
+
+/**
+ * Function: gIndexedHeapIncreaseKey
+ * ---------------------------------
+ * Replace the element of a handle by one that is not smaller, O(log n)
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOITM if the handle is not in use,
+ *                  G_EINVAL if elem is smaller than the element it replaces.
+ */
+int gIndexedHeapIncreaseKey(gIndexedHeap *heap, size_t handle, const void *elem);
+
+/**
+ * Function: gIndexedHeapUpdate
+ * ----------------------------
+ * Replace the element of a handle by any other, O(log n)
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOITM if the handle is not in use.
+ */
+int gIndexedHeapUpdate(gIndexedHeap *heap, size_t handle, const void *elem);
+
+/**
+ * Function: gIndexedHeapRemove
+ * ----------------------------
+ * Remove the element of a handle, O(log n), the handle is freed
+ *
+ * @param heap      The heap
+ * @param handle    Handle of the element
+ * @param out       Receives the element, may be NULL
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOITM if the handle is not in use.
+ */
+int gIndexedHeapRemove(gIndexedHeap *heap, size_t handle, void *out);
+
+#endif //LIBGENERIC_INDEXEDHEAP_H
@@ -0,0 +1,164 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	itree.h
+ *
+ * @brief	Interval tree built on a self balancing (AVL) binary search tree.
+ *
+ * Every node stores a closed interval [lo, hi] and is ordered by lo. Each node
+ * additionally remembers the largest hi found in its subtree, which lets the
+ * overlap queries skip every subtree that cannot contain a match.
+ */
+
+#ifndef LIBGENERIC_ITREE_H
+#define LIBGENERIC_ITREE_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <generic.h>
+#include <generic/utils.h>
+
+/** @brief Interval tree node
+ *
+ * Assuming the members are read-only to users
+ */
+typedef struct ivl_node {
+    /** @brief Lower endpoint of the interval */
+    void *lo;
+    /** @brief Upper endpoint of the interval */
+    void *hi;
+    /** @brief Data attached to the interval */
+    void *data;
+    /** @brief Largest upper endpoint in the subtree rooted at this node
+     *
+     * Points to the hi of one of the nodes of the subtree, never a copy.
+     */
+    const void *max;
+    /** @brief Left node
+     *
+     * Every interval in the left subtree starts before the current one
+     */
+    struct ivl_node *left;
+    /** @brief Right node
+     *
+     * Every interval in the right subtree starts at or after the current one
+     */
+    struct ivl_node *right;
+    /** @brief Height of the subtree rooted at this node, leaves are 1 */
+    int height;
+} ivl_node_t;
+
+typedef struct {
+    ivl_node_t *root;
+    cmpfunc_t compare;
+    size_t keySize;
+    size_t elementSize;
+    size_t size;
+} gIntervalTree;
+
+/**
+ * This type is used to receive the intervals found by an overlap query.
+ *
+ * Expected behaviour:
+ *      Should return (0) to continue the query,
+ *      anything else stops it.
+ */
+typedef int (*gIntervalVisit)(ivl_node_t *node, void *ctx);
+
+/**
+ * Function: gIntervalTreeCreate
+ * -----------------------------
+ * Create an empty interval tree
+ *
+ * @param keySize       The size of an interval endpoint
+ * @param elementSize   The size of the data attached to every interval,
+ *                      may be 0 if no data is needed.
+ * @param compare       The function used to compare two endpoints
+ *
+ * @return              Pointer to the new interval tree
+ *                      will return NULL in case of failure
+ */
+gIntervalTree *gIntervalTreeCreate(size_t keySize, size_t elementSize, cmpfunc_t compare);
+
+/**
+ * Function: gIntervalTreeAdd
+ * --------------------------
+ * Add the closed interval [lo, hi] to the tree.
+ * The endpoints and the item are copied into the tree.
+ *
+ * @param tree  The tree where the interval is to be added
+ * @param lo    Lower endpoint
+ * @param hi    Upper endpoint, must not be less than lo
+ * @param item  The data attached to the interval, ignored if
+ *              the tree was created with elementSize 0
+ *
+ * @return      status code of operation
+ *              (0) if success, error code in case of failure.
+ */
+int gIntervalTreeAdd(gIntervalTree *tree, void *lo, void *hi, void *item);
+
+/**
+ * Function: gIntervalTreeDelete
+ * -----------------------------
+ * Delete a tree and every interval stored in it
+ *
+ * @param tree	Interval tree that's being deleted.
+ */
+void gIntervalTreeDelete(gIntervalTree *tree);
+
+/**
+ * Function: gIntervalOverlaps
+ * ---------------------------
+ * Find every interval containing a point, that is lo <= point <= hi.
+ * Subtrees whose largest upper endpoint is below the point and right
+ * subtrees of nodes starting after the point are never visited.
+ *
+ * @param tree      The tree to be searched
+ * @param point     The point to look for
+ * @param visit     Called for every matching node, may be NULL to only count
+ * @param ctx       Passed unchanged to visit
+ *
+ * @return          Number of matching intervals reported
+ */
+size_t gIntervalOverlaps(gIntervalTree *tree, void *point, gIntervalVisit visit, void *ctx);
+
+/**
+ * Function: gIntervalOverlapsRange
+ * --------------------------------
+ * Find every interval overlapping the closed range [lo, hi],
+ * that is every interval with its lo <= hi and its hi >= lo.
+ *
+ * @param tree      The tree to be searched
+ * @param lo        Lower endpoint of the range
+ * @param hi        Upper endpoint of the range
+ * @param visit     Called for every matching node, may be NULL to only count
+ * @param ctx       Passed unchanged to visit
+ *
+ * @return          Number of matching intervals reported
+ */
+size_t gIntervalOverlapsRange(gIntervalTree *tree, void *lo, void *hi, gIntervalVisit visit, void *ctx);
+
+#endif //LIBGENERIC_ITREE_H
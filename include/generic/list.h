@@ -63,6 +63,29 @@ typedef struct gList{
 
 typedef node** gListIterator;
 
+/**
+ * Links of an intrusive doubly linked list. Embed it in your own
+ * structure and get back to the structure with gDLIST_ENTRY; the list
+ * never allocates or copies anything.
+ *
+ * A list is a circular chain through a head dnode that holds no item,
+ * an empty list is a head pointing to itself.
+ */
+typedef struct dnode {
+    struct dnode *prev;
+    struct dnode *next;
+} dnode;
+
+/**
+ * Get the structure containing a dnode
+ *
+ *  Example
+ *      struct entry { int value; dnode link; };
+ *      struct entry *e = gDLIST_ENTRY(head.next, struct entry, link);
+ */
+#define gDLIST_ENTRY(ptr, type, member) \
+    ((type *) ((char *) (ptr) - offsetof(type, member)))
+
 /**
  * Used to signal the functions that the operation should be done
  * to last item of the list
@@ -205,6 +228,78 @@ int gListIterate(gListIterator iter);
  *                      correctly access it.
  *                      May return 'NULL' in that case of invalid iterator, or empty list.
  */
-void* gListGetIteratorData(gListIterator iterator);
+G_ACCESSOR void* gListGetIteratorData(gListIterator iterator);
+
+/**
+ * Function: gDListInit
+ * ----------------------
+ * Makes a dnode the head of an empty list
+ *
+ *  @param head:    The head of the list.
+ */
+void gDListInit(dnode *head);
+
+/**
+ * Function: gDListIsEmpty
+ * ----------------------
+ *  @param head:    The head of the list.
+ *
+ *  @return:        (1) if the list has no item, (0) otherwise.
+ */
+int gDListIsEmpty(dnode *head);
+
+/**
+ * Function: gDListPushFront
+ * ----------------------
+ * Links a node right after the head. Takes constant time.
+ *
+ *  @param head:    The head of the list.
+ *  @param item:    A node that is not in any list.
+ */
+void gDListPushFront(dnode *head, dnode *item);
+
+/**
+ * Function: gDListPushBack
+ * ----------------------
+ * Links a node right before the head. Takes constant time.
+ *
+ *  @param head:    The head of the list.
+ *  @param item:    A node that is not in any list.
+ */
+void gDListPushBack(dnode *head, dnode *item);
+
+/**
+ * Function: gDListRemove
+ * ----------------------
+ * Unlinks a node from the list it is in. Takes constant time, the
+ * list itself is not needed.
+ *
+ *  @param item:    The node to be removed.
+ */
+void gDListRemove(dnode *item);
+
+/**
+ * Function: gDListMoveFront
+ * ----------------------
+ * Moves a node of the list right after the head.
+ *
+ *  @param head:    The head of the list.
+ *  @param item:    A node of the list.
+ */
+void gDListMoveFront(dnode *head, dnode *item);
+
+/* Accessors, defined here to be inlined with GENERIC_INLINE */
+#if defined(GENERIC_INLINE) || defined(LIST_ACCESSORS_IMPL)
+
+G_ACCESSOR void *gListGetIteratorData(gListIterator iter) {
+    G_DEBUG_ASSERT(iter != NULL);
+    if (*iter == NULL) {
+        gErrorCode = G_EITMEND;
+        return NULL;
+    }
+    return (*iter)->data;
+}
+
+#endif
 
 #endif //DATA_STRUCTURE_LIST_H
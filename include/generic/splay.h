@@ -0,0 +1,106 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	splay.h
+ *
+ * @brief	Self adjusting binary search tree.
+ *
+ * Every search and insert splays the touched node to the root, so frequently
+ * accessed items end up close to the root and are found in few steps. Any
+ * sequence of m operations costs O(m log n) amortized; on skewed access
+ * patterns it is much closer to the entropy of the access distribution.
+ * The tree uses the same nodes as @ref bst.h.
+ */
+
+#ifndef LIBGENERIC_SPLAY_H
+#define LIBGENERIC_SPLAY_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <generic.h>
+#include <generic/utils.h>
+#include <generic/bst.h>
+
+typedef struct gSplay {
+    bnode_t *root;
+    gDataCompare isGreater;
+    size_t elementSize;
+    size_t size;
+} gSplay;
+
+/**
+ * Function: gSplayCreate
+ * ----------------------
+ * Create an empty splay tree
+ *
+ * @param elementSize   The size of data to be stored.
+ * @param comparator    The function to be used to compare the
+ *                      elements
+ *
+ * @return	            Pointer to the new splay tree
+ *                      will return NULL in case of failure
+ */
+gSplay *gSplayCreate(size_t elementSize, gDataCompare comparator);
+
+/**
+ * Function: gSplayAdd
+ * -------------------
+ * Add element to the tree, the new element becomes the root.
+ *
+ * @param tree  The tree where the item is to be added.
+ * @param item  The item to be added
+ *
+ * @return      status code of operation
+ *              (0) if success, error code in case of failure.
+ */
+int gSplayAdd(gSplay *tree, void *item);
+
+/**
+ * Function: gSplayDelete
+ * ----------------------
+ * Delete a tree
+ *
+ * @param tree:	Splay tree that's being deleted.
+ */
+void gSplayDelete(gSplay *tree);
+
+/**
+ * Function: gSplaySearch
+ * ----------------------
+ * Search an item in the tree. The last node visited by the search
+ * is moved to the root, even if the item is not found.
+ *
+ * Two items are considered equal when neither is greater than the
+ * other according to the comparator.
+ *
+ * @param tree      The tree to be searched
+ * @param data      The item to be searched
+ *
+ * @return	Node containing the found item, NULL if not found
+ */
+bnode_t *gSplaySearch(gSplay *tree, void *data);
+
+#endif //LIBGENERIC_SPLAY_H
@@ -0,0 +1,176 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	timerwheel.h
+ *
+ * @brief	Hierarchical timing wheel for large numbers of timers.
+ *
+ * Time is counted in ticks. Level 0 has one slot per tick for the next
+ * 256 ticks, each slot of level k covers 256^k ticks. A timer is linked
+ * into the slot of the coarsest level that still tells its tick apart,
+ * and is cascaded to a finer level when the wheel reaches its slot.
+ * Timers more than 2^32 ticks away wait in the last level and are placed
+ * again each time it turns.
+ *
+ * Timers are intrusive, embed a gTimer in your own structure and get back
+ * to it with gDLIST_ENTRY. The wheel never allocates per timer, so
+ * scheduling, rescheduling and cancelling are O(1) and never fail.
+ */
+
+#ifndef LIBGENERIC_TIMERWHEEL_H
+#define LIBGENERIC_TIMERWHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <generic.h>
+#include <generic/list.h>
+
+/** @brief Log2 of the number of slots of a level */
+#define	TIMER_WHEEL_BITS	8
+
+/** @brief Number of slots of a level */
+#define	TIMER_WHEEL_SLOTS	(1 << TIMER_WHEEL_BITS)
+
+/** @brief Number of levels, they span 2^32 ticks */
+#define	TIMER_WHEEL_LEVELS	4
+
+/** @brief A timer, embed it in your own structure
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gTimer {
+    /** @brief Links the timer into its slot, points to itself when idle */
+    dnode link;
+    /** @brief Tick at which the timer expires */
+    uint64_t expires;
+} gTimer;
+
+/** @brief The structure of timing wheel
+ *
+ * Assuming those members are read-only
+ */
+typedef struct gTimerWheel {
+    dnode slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    /** @brief Next tick to expire, timers of earlier ticks have fired */
+    uint64_t tick;
+    /** @brief Number of pending timers */
+    size_t n;
+} gTimerWheel;
+
+/** @brief Called for each expired timer
+ *
+ * The timer is already idle, it may be scheduled again or freed.
+ */
+typedef void (*gTimerFunc)(gTimer *timer, void *arg);
+
+/**
+ * Function: gTimerInit
+ * --------------------
+ * Make a timer idle, call it once before the timer is first scheduled
+ *
+ * @param timer     The timer
+ */
+void gTimerInit(gTimer *timer);
+
+/**
+ * Function: gTimerPending
+ * -----------------------
+ * @param timer     The timer
+ *
+ * @return          (1) if the timer is scheduled, (0) if it is idle.
+ */
+int gTimerPending(const gTimer *timer);
+
+/**
+ * Function: gTimerWheelCreate
+ * ---------------------------
+ * Create an empty timing wheel
+ *
+ * @param now       The current tick, the first tick to expire
+ *
+ * @return          The wheel or NULL if there is no memory (see gErrorCode)
+ */
+gTimerWheel *gTimerWheelCreate(uint64_t now);
+
+/**
+ * Function: gTimerWheelDelete
+ * ---------------------------
+ * Delete a wheel, the timers still pending are made idle
+ *
+ * @param wheel     The wheel
+ */
+void gTimerWheelDelete(gTimerWheel *wheel);
+
+/**
+ * Function: gTimerWheelSchedule
+ * -----------------------------
+ * Schedule a timer, or move it if it is already pending, O(1)
+ *
+ * A timer for a tick that has already been expired fires on the next
+ * call to gTimerWheelAdvance.
+ *
+ * @param wheel     The wheel
+ * @param timer     An idle timer or one pending in this wheel
+ * @param expires   Tick at which the timer fires
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_EINVLD if wheel or timer is NULL.
+ */
+int gTimerWheelSchedule(gTimerWheel *wheel, gTimer *timer, uint64_t expires);
+
+/**
+ * Function: gTimerWheelCancel
+ * ---------------------------
+ * Make a pending timer idle without firing it, O(1)
+ *
+ * @param wheel     The wheel
+ * @param timer     A timer pending in this wheel
+ *
+ * @return          status code of operation
+ *                  (0) if success, G_ENOITM if the timer is idle.
+ */
+int gTimerWheelCancel(gTimerWheel *wheel, gTimer *timer);
+
+/**
+ * Function: gTimerWheelAdvance
+ * ----------------------------
+ * Expire every timer of the ticks up to now, a tick at a time
+ *
+ * expire may schedule and cancel timers, including the ones of the
+ * tick being fired; a timer scheduled for a past tick fires with the
+ * next tick.
+ *
+ * @param wheel     The wheel
+ * @param now       The last tick to expire
+ * @param expire    Called with each expired timer
+ * @param arg       Passed to expire
+ *
+ * @return          The number of timers fired, 0 with G_EINVLD if wheel
+ *                  or expire is NULL
+ */
+size_t gTimerWheelAdvance(gTimerWheel *wheel, uint64_t now, gTimerFunc expire, void *arg);
+
+#endif //LIBGENERIC_TIMERWHEEL_H
@@ -0,0 +1,422 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	typed.h
+ *
+ * @brief	Macros that generate containers and sorts for one type.
+ *
+ * The other containers store elements of any size behind void pointers,
+ * copy them with memcpy and compare them through a function pointer.
+ * The code generated here knows the type, so elements are moved by plain
+ * assignment and the comparison is inlined:
+ *
+ *      #define LESS_INT(a, b) ((a) < (b))
+ *      GVECTOR_DEFINE(IntVector, int)
+ *      GHEAP_DEFINE(IntHeap, int, LESS_INT)
+ *      GSORT_DEFINE(sortInts, int, LESS_INT)
+ *
+ * declares the IntVector and IntHeap types with IntVectorPushBack(),
+ * IntHeapPop() etc. and the function sortInts(int *a, size_t n).
+ *
+ * LESS(a, b) is given two elements and is true, any non-zero value, if a
+ * goes before b. It is a macro or a function, and may evaluate its
+ * arguments more than once.
+ *
+ * Everything is static inline, use each macro once per type in a header
+ * or a source file. Errors are reported like the other containers,
+ * through the return value and gErrorCode.
+ */
+
+#ifndef LIBGENERIC_TYPED_H
+#define LIBGENERIC_TYPED_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <generic.h>
+
+/** @brief Elements allocated by the first push */
+#define	GTYPED_DEFAULT_ELEMS	16
+
+/** @brief Ranges of at most this many elements are insertion sorted */
+#define	GSORT_INSERTION	16
+
+/** @brief Ranges longer than this take a pivot from 9 elements */
+#define	GSORT_NINTHER	128
+
+/**
+ * Macro: GVECTOR_DEFINE
+ * ---------------------
+ * Define the vector type name of elements T and its functions, named
+ * like the gVector ones:
+ *
+ *  void name##Create(name *v)          Make an empty vector, allocates nothing
+ *  void name##Destroy(name *v)         Free the elements
+ *  int  name##Reserve(name *v, n)      Make room for n elements
+ *  int  name##Resize(name *v, n)       Set the length, new elements are
+ *                                      uninitialized
+ *  int  name##PushBack(name *v, T x)
+ *  T   *name##PopBack(name *v)         NULL if empty, the element stays
+ *                                      valid until the next push
+ *  T   *name##ItemAt(name *v, i)       No bound checks
+ *  T   *name##Front(name *v), name##Back(name *v)
+ *  T   *name##Set(name *v, pos, T x)
+ *  T   *name##Insert(name *v, pos, T x)    NULL if out of memory
+ *
+ * The int functions return 0, or G_ENOMEN and leave the vector unchanged.
+ */
+#define GVECTOR_DEFINE(name, T) \
+typedef struct name { \
+    T *elems; \
+    size_t n; \
+    /** @brief Number of elements allocated */ \
+    size_t alloc; \
+} name; \
+\
+static inline void name##Create(name *v) { \
+    v->elems = NULL; \
+    v->n = 0; \
+    v->alloc = 0; \
+} \
+\
+static inline void name##Destroy(name *v) { \
+    free(v->elems); \
+    name##Create(v); \
+} \
+\
+static inline int name##Reserve(name *v, size_t n) { \
+    if (n <= v->alloc) { \
+        return 0; \
+    } \
+    size_t alloc = v->alloc ? v->alloc * 2 : GTYPED_DEFAULT_ELEMS; \
+    if (alloc < n) { \
+        alloc = n; \
+    } \
+    T *elems = (T *) realloc(v->elems, alloc * sizeof(T)); \
+    if (elems == NULL) { \
+        gErrorCode = G_ENOMEN; \
+        return G_ENOMEN; \
+    } \
+    v->elems = elems; \
+    v->alloc = alloc; \
+    return 0; \
+} \
+\
+static inline int name##Resize(name *v, size_t n) { \
+    if (name##Reserve(v, n) != 0) { \
+        return G_ENOMEN; \
+    } \
+    v->n = n; \
+    return 0; \
+} \
+\
+static inline int name##PushBack(name *v, T value) { \
+    if (v->n == v->alloc && name##Reserve(v, v->n + 1) != 0) { \
+        return G_ENOMEN; \
+    } \
+    v->elems[v->n++] = value; \
+    return 0; \
+} \
+\
+static inline T *name##PopBack(name *v) { \
+    return v->n > 0 ? &v->elems[--v->n] : NULL; \
+} \
+\
+static inline T *name##ItemAt(name *v, size_t index) { \
+    return &v->elems[index]; \
+} \
+\
+static inline T *name##Front(name *v) { \
+    return v->elems; \
+} \
+\
+static inline T *name##Back(name *v) { \
+    return v->n > 0 ? &v->elems[v->n - 1] : v->elems; \
+} \
+\
+static inline T *name##Set(name *v, size_t pos, T value) { \
+    v->elems[pos] = value; \
+    return &v->elems[pos]; \
+} \
+\
+static inline T *name##Insert(name *v, size_t pos, T value) { \
+    if (v->n == v->alloc && name##Reserve(v, v->n + 1) != 0) { \
+        return NULL; \
+    } \
+    memmove(&v->elems[pos + 1], &v->elems[pos], (v->n - pos) * sizeof(T)); \
+    v->elems[pos] = value; \
+    v->n++; \
+    return &v->elems[pos]; \
+}
+
+/**
+ * Macro: GHEAP_DEFINE
+ * -------------------
+ * Define the 4-ary heap type name of elements T and its functions, named
+ * like the gHeap ones. The top is the smallest element for LESS.
+ *
+ *  void name##Create(name *h)          Make an empty heap, allocates nothing
+ *  void name##Destroy(name *h)         Free the elements
+ *  int  name##Reserve(name *h, n)      Make room for n elements
+ *  int  name##Push(name *h, T x)       (0) or G_ENOMEN
+ *  T   *name##Top(name *h)             NULL if empty
+ *  int  name##Pop(name *h, T *out)     (0) or G_ENOITM, out may be NULL
+ *  int  name##ReplaceTop(name *h, T x, T *out)
+ *                                      Pop then push in one pass
+ */
+#define GHEAP_DEFINE(name, T, LESS) \
+typedef struct name { \
+    T *elems; \
+    size_t n; \
+    size_t capacity; \
+} name; \
+\
+static inline void name##Create(name *h) { \
+    h->elems = NULL; \
+    h->n = 0; \
+    h->capacity = 0; \
+} \
+\
+static inline void name##Destroy(name *h) { \
+    free(h->elems); \
+    name##Create(h); \
+} \
+\
+static inline int name##Reserve(name *h, size_t n) { \
+    if (n <= h->capacity) { \
+        return 0; \
+    } \
+    size_t capacity = h->capacity ? h->capacity * 2 : GTYPED_DEFAULT_ELEMS; \
+    if (capacity < n) { \
+        capacity = n; \
+    } \
+    T *elems = (T *) realloc(h->elems, capacity * sizeof(T)); \
+    if (elems == NULL) { \
+        gErrorCode = G_ENOMEN; \
+        return G_ENOMEN; \
+    } \
+    h->elems = elems; \
+    h->capacity = capacity; \
+    return 0; \
+} \
+\
+static inline void name##SiftDown(name *h, size_t i, T x) { \
+    T *a = h->elems; \
+    size_t n = h->n, first, last, best, c; \
+    while ((first = 4 * i + 1) < n) { \
+        last = first + 4 < n ? first + 4 : n; \
+        best = first; \
+        for (c = first + 1; c < last; c++) { \
+            if (LESS(a[c], a[best])) { \
+                best = c; \
+            } \
+        } \
+        if (!LESS(a[best], x)) { \
+            break; \
+        } \
+        a[i] = a[best]; \
+        i = best; \
+    } \
+    a[i] = x; \
+} \
+\
+static inline int name##Push(name *h, T x) { \
+    if (h->n == h->capacity && name##Reserve(h, h->n + 1) != 0) { \
+        return G_ENOMEN; \
+    } \
+    T *a = h->elems; \
+    size_t i = h->n++; \
+    while (i > 0 && LESS(x, a[(i - 1) / 4])) { \
+        a[i] = a[(i - 1) / 4]; \
+        i = (i - 1) / 4; \
+    } \
+    a[i] = x; \
+    return 0; \
+} \
+\
+static inline T *name##Top(name *h) { \
+    return h->n > 0 ? h->elems : NULL; \
+} \
+\
+static inline int name##Pop(name *h, T *out) { \
+    if (h->n == 0) { \
+        gErrorCode = G_ENOITM; \
+        return G_ENOITM; \
+    } \
+    if (out != NULL) { \
+        *out = h->elems[0]; \
+    } \
+    h->n--; \
+    if (h->n > 0) { \
+        name##SiftDown(h, 0, h->elems[h->n]); \
+    } \
+    return 0; \
+} \
+\
+static inline int name##ReplaceTop(name *h, T x, T *out) { \
+    if (h->n == 0) { \
+        gErrorCode = G_ENOITM; \
+        return G_ENOITM; \
+    } \
+    if (out != NULL) { \
+        *out = h->elems[0]; \
+    } \
+    name##SiftDown(h, 0, x); \
+    return 0; \
+}
+
+/**
+ * Macro: GSORT_DEFINE
+ * -------------------
+ * Define void name(T *a, size_t n), an unstable in-place sort of n
+ * elements in the order of LESS.
+ *
+ * It is an introsort: quicksort around a median of 3, insertion sort on
+ * short ranges and heapsort when the recursion gets too deep, so the
+ * worst case stays O(n log n).
+ */
+#define GSORT_DEFINE(name, T, LESS) \
+static inline void name##Insertion(T *a, size_t n) { \
+    size_t i, j; \
+    for (i = 1; i < n; i++) { \
+        T x = a[i]; \
+        for (j = i; j > 0 && LESS(x, a[j - 1]); j--) { \
+            a[j] = a[j - 1]; \
+        } \
+        a[j] = x; \
+    } \
+} \
+\
+static inline void name##SiftDown(T *a, size_t i, size_t n) { \
+    T x = a[i]; \
+    size_t c; \
+    while ((c = 2 * i + 1) < n) { \
+        if (c + 1 < n && LESS(a[c], a[c + 1])) { \
+            c++; \
+        } \
+        if (!LESS(x, a[c])) { \
+            break; \
+        } \
+        a[i] = a[c]; \
+        i = c; \
+    } \
+    a[i] = x; \
+} \
+\
+static inline void name##HeapSort(T *a, size_t n) { \
+    size_t i; \
+    T x; \
+    for (i = n / 2; i-- > 0;) { \
+        name##SiftDown(a, i, n); \
+    } \
+    while (n > 1) { \
+        n--; \
+        x = a[0]; \
+        a[0] = a[n]; \
+        a[n] = x; \
+        name##SiftDown(a, 0, n); \
+    } \
+} \
+\
+static inline void name##Sort3(T *a, size_t i, size_t j, size_t k) { \
+    T x; \
+    if (LESS(a[j], a[i])) { \
+        x = a[i]; a[i] = a[j]; a[j] = x; \
+    } \
+    if (LESS(a[k], a[j])) { \
+        x = a[j]; a[j] = a[k]; a[k] = x; \
+        if (LESS(a[j], a[i])) { \
+            x = a[i]; a[i] = a[j]; a[j] = x; \
+        } \
+    } \
+} \
+\
+static inline void name##Intro(T *a, size_t n, unsigned int depth, int leftmost) { \
+    T x, pivot; \
+    size_t m, lt, k; \
+    while (n > GSORT_INSERTION) { \
+        if (depth-- == 0) { \
+            name##HeapSort(a, n); \
+            return; \
+        } \
+        /* Median of 3, or of 3 medians on long ranges, to a[0] */ \
+        m = n / 2; \
+        name##Sort3(a, 0, m, n - 1); \
+        if (n > GSORT_NINTHER) { \
+            name##Sort3(a, 1, m - 1, n - 2); \
+            name##Sort3(a, 2, m + 1, n - 3); \
+            name##Sort3(a, m - 1, m, m + 1); \
+        } \
+        pivot = a[m]; \
+        a[m] = a[0]; \
+        a[0] = pivot; \
+        lt = 1; \
+        if (!leftmost && !LESS(a[-1], pivot)) { \
+            /* The pivot equals the one before the range, which is not \
+             * above anything in it: skip past the elements equal to it */ \
+            for (k = 1; k < n; k++) { \
+                x = a[k]; \
+                a[k] = a[lt]; \
+                a[lt] = x; \
+                lt += !LESS(pivot, x); \
+            } \
+            a += lt; \
+            n -= lt; \
+            continue; \
+        } \
+        /* Lomuto partition without branches on the comparisons */ \
+        for (k = 1; k < n; k++) { \
+            x = a[k]; \
+            a[k] = a[lt]; \
+            a[lt] = x; \
+            lt += (LESS(x, pivot)) != 0; \
+        } \
+        a[0] = a[lt - 1]; \
+        a[lt - 1] = pivot; \
+        /* a[0, lt - 1) is below the pivot, a[lt, n) not below it */ \
+        if (lt - 1 < n - lt) { \
+            name##Intro(a, lt - 1, depth, leftmost); \
+            a += lt; \
+            n -= lt; \
+            leftmost = 0; \
+        } else { \
+            name##Intro(a + lt, n - lt, depth, 0); \
+            n = lt - 1; \
+        } \
+    } \
+    name##Insertion(a, n); \
+} \
+\
+static inline void name(T *a, size_t n) { \
+    unsigned int depth = 0; \
+    size_t k; \
+    for (k = n; k > 1; k >>= 1) { \
+        depth += 2; \
+    } \
+    name##Intro(a, n, depth, 1); \
+}
+
+#endif //LIBGENERIC_TYPED_H
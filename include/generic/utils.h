@@ -34,9 +34,13 @@
 #define	_GENERIC_UTILS_H_
 
 #include <stddef.h>	// size_t
+#include <stdint.h>
 #include <generic.h>
 
 /** @brief Swap bytes between two locations
+ *
+ * The bytes are moved by blocks of 32, then by words, so swapping whole
+ * arrays is cheap too. The locations must not overlap.
  *
  * @param a	    The pointer to the first field
  * @param b	    The pointer to the second field
@@ -61,6 +65,47 @@ void gSwap(void *a, void *b, size_t sz);
  */
 void *gSearch(const void *key, const void *base, size_t n, size_t elem_sz, cmpfunc_t cmpfunc);
 
+/**
+ * Function: gSearchI32
+ * --------------------
+ * Search an int32_t array for a value, without a compare function
+ *
+ * On x86 the elements are compared 16 at a time with SSE2, or 32 at a
+ * time with AVX2 when the CPU supports it. Elsewhere, or when built with
+ * GENERIC_NO_AVX2 or without SSE2, a plain loop is used.
+ *
+ * @param base	    The elements to be searched
+ * @param n 	    The number of elements in the base
+ * @param key	    The value to search
+ *
+ * @return          The first element equal to key or NULL if not found
+ */
+const int32_t *gSearchI32(const int32_t *base, size_t n, int32_t key);
+
+/**
+ * Function: gSearchI64
+ * --------------------
+ * Search an int64_t array for a value, see gSearchI32
+ */
+const int64_t *gSearchI64(const int64_t *base, size_t n, int64_t key);
+
+/**
+ * Function: gSearchU8
+ * -------------------
+ * Search a byte array for a value, this is memchr
+ */
+const uint8_t *gSearchU8(const uint8_t *base, size_t n, uint8_t key);
+
+/**
+ * Function: gSearchF32
+ * --------------------
+ * Search a float array for a value, see gSearchI32
+ *
+ * Elements are compared with ==, so 0.0 and -0.0 match each other and
+ * NaN matches nothing.
+ */
+const float *gSearchF32(const float *base, size_t n, float key);
+
 /**
  * Function: gReverse
  * ------------------
@@ -75,6 +120,25 @@ void *gSearch(const void *key, const void *base, size_t n, size_t elem_sz, cmpfu
  */
 void *gReverse(void *elems, size_t n, size_t elem_sz);
 
+/**
+ * Function: gRotate
+ * -----------------
+ * Rotate the elements in a contigous region to the left, in place
+ *
+ * Element k becomes the first one and the first k elements go to the end,
+ * like std::rotate. It takes about n element swaps, done by blocks.
+ *
+ *  @param elems	Pointer to the elements
+ *  @param n		Number of elements
+ *  @param elem_sz	Size of each element
+ *  @param k		Index of the new first element, nothing is done
+ *		            if it is 0 or not less than n
+ *
+ *  @return	        Pointer to the rotated elements
+ *		            Always equal to elems
+ */
+void *gRotate(void *elems, size_t n, size_t elem_sz, size_t k);
+
 /**
  * This type is used to implement comparision function to be used
  * by algorithms and container when it needs to compare two data.
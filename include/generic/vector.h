@@ -31,6 +31,9 @@
 #define	DATA_STRUCTURE_VECTOR_H
 #include <stddef.h>	// size_t
 #include <stdlib.h>
+#include <string.h>
+
+#include <generic.h>
 
 
 /** @brief Default number of elements of vector
@@ -115,7 +118,7 @@ void *gVectorPopBack(gVector *vector);
  *
  * @return	Pointer to the element
  */
-void *gVectorItemAt(gVector *vector, size_t index);
+G_ACCESSOR void *gVectorItemAt(gVector *vector, size_t index);
 
 /**
  * Function: gVectorResize
@@ -124,6 +127,7 @@ void *gVectorItemAt(gVector *vector, size_t index);
  * Reallocates the elements in the vector
  *
  * Warning: Data maybe lost in case of shrinking vector size.
+ * If the allocation fails the vector is left unchanged (G_ENOMEN).
  *
  * @param vector	Vector to be resized
  * @param new_size	The new size for the vector
@@ -140,7 +144,7 @@ void gVectorResize(gVector *vector, size_t new_size);
  *
  * @return			The pointer to the first element
  */
-void *gVectorFront(gVector *vector);
+G_ACCESSOR void *gVectorFront(gVector *vector);
 
 /**
  * Function: gVectorBack
@@ -152,7 +156,7 @@ void *gVectorFront(gVector *vector);
  * @return			The pointer to the last element
  *
  */
-void *gVectorBack(gVector *vector);
+G_ACCESSOR void *gVectorBack(gVector *vector);
 
 /**
  * Function: gVectorSet
@@ -165,7 +169,7 @@ void *gVectorBack(gVector *vector);
  *
  * @return			Position of the value
  */
-void *gVectorSet(gVector *vector, size_t pos, void *val);
+G_ACCESSOR void *gVectorSet(gVector *vector, size_t pos, void *val);
 
 /**
  * Function: gVectorInsert
@@ -183,6 +187,37 @@ void *gVectorSet(gVector *vector, size_t pos, void *val);
  */
 void *gVectorInsert(gVector *vector, size_t pos, void *val);
 
+/* Accessors, defined here to be inlined with GENERIC_INLINE */
+#if defined(GENERIC_INLINE) || defined(VECTOR_ACCESSORS_IMPL)
+
+G_ACCESSOR void *gVectorItemAt(gVector *vector, size_t index) {
+    G_DEBUG_ASSERT(vector != NULL);
+    G_DEBUG_ASSERT(index <= vector->n);
+    return (char *) vector->elems + index * vector->elem_sz;
+}
+
+G_ACCESSOR void *gVectorFront(gVector *vector) {
+    G_DEBUG_ASSERT(vector != NULL);
+    return vector->elems;
+}
+
+G_ACCESSOR void *gVectorBack(gVector *vector) {
+    G_DEBUG_ASSERT(vector != NULL);
+    if (vector->n == 0) {
+        return vector->elems;
+    }
+    return gVectorItemAt(vector, vector->n - 1);
+}
+
+G_ACCESSOR void *gVectorSet(gVector *vector, size_t pos, void *val) {
+    G_DEBUG_ASSERT(val != NULL);
+    void *ptr = gVectorItemAt(vector, pos);
+    memcpy(ptr, val, vector->elem_sz);
+    return ptr;
+}
+
+#endif
+
 /* Optional Queue wrapper */
 #ifdef	ENABLE_QUEUE
 
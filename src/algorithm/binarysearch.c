@@ -0,0 +1,133 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/algorithm/binarysearch.h>
+#include <assert.h>
+/** @addtogroup binarysearch
+ * @{
+ */
+
+#if defined(__GNUC__)
+#define	PREFETCH(p)	__builtin_prefetch(p)
+#else
+#define	PREFETCH(p)	((void)(p))
+#endif
+
+/** @brief Internal function finding the first element for which
+ * cmpfunc(element,key) reaches limit
+ *
+ * limit is 0 for the lower bound and 1 for the upper bound.
+ */
+static size_t bound(const void *key,const char *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,int limit)
+{
+	const char *first=base;
+	if(n==0){
+		return 0;
+	}
+	// The answer stays within [base,base+n]
+	while(n>1){
+		size_t half=n/2;
+		PREFETCH(base+(half/2)*elem_sz);
+		PREFETCH(base+(half+half/2)*elem_sz);
+		base=cmpfunc((void*)(base+half*elem_sz),(void*)key)<limit?base+half*elem_sz:base;
+		n-=half;
+	}
+	return (size_t)(base-first)/elem_sz+(cmpfunc((void*)base,(void*)key)<limit);
+}
+
+size_t gLowerBound(const void *key,const void *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc)
+{
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	return bound(key,(const char*)base,n,elem_sz,cmpfunc,0);
+}
+
+size_t gUpperBound(const void *key,const void *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc)
+{
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	return bound(key,(const char*)base,n,elem_sz,cmpfunc,1);
+}
+
+void gEqualRange(const void *key,const void *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,size_t *first,size_t *last)
+{
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	size_t lo=bound(key,(const char*)base,n,elem_sz,cmpfunc,0);
+	*first=lo;
+	*last=lo+bound(key,(const char*)base+lo*elem_sz,n-lo,elem_sz,cmpfunc,1);
+}
+
+void *gBinarySearch(const void *key,const void *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc)
+{
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	size_t i=bound(key,(const char*)base,n,elem_sz,cmpfunc,0);
+	char *found=(char*)base+i*elem_sz;
+	if(i==n||cmpfunc(found,(void*)key)!=0){
+		return NULL;
+	}
+	return found;
+}
+
+/** @brief Defines the lower and upper bounds for a primitive type
+ *
+ * Same loop as bound, with the comparison inlined.
+ */
+#define	DEFINE_BOUNDS(suffix,type)	\
+size_t gLowerBound##suffix(const type *base,size_t n,type key)	\
+{	\
+	const type *first=base;	\
+	if(n==0){	\
+		return 0;	\
+	}	\
+	while(n>1){	\
+		size_t half=n/2;	\
+		PREFETCH(base+half/2);	\
+		PREFETCH(base+half+half/2);	\
+		base=base[half]<key?base+half:base;	\
+		n-=half;	\
+	}	\
+	return (size_t)(base-first)+(*base<key);	\
+}	\
+size_t gUpperBound##suffix(const type *base,size_t n,type key)	\
+{	\
+	const type *first=base;	\
+	if(n==0){	\
+		return 0;	\
+	}	\
+	while(n>1){	\
+		size_t half=n/2;	\
+		PREFETCH(base+half/2);	\
+		PREFETCH(base+half+half/2);	\
+		base=base[half]<=key?base+half:base;	\
+		n-=half;	\
+	}	\
+	return (size_t)(base-first)+(*base<=key);	\
+}
+
+DEFINE_BOUNDS(I32,int32_t)
+DEFINE_BOUNDS(I64,int64_t)
+DEFINE_BOUNDS(U64,uint64_t)
+/** @} */
@@ -0,0 +1,352 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/algorithm/extsort.h>
+#include "losertree.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+/** @addtogroup extsort
+ * @{
+ */
+
+/** @brief Smallest read or write worth a merge pass, in bytes */
+#define	EXTSORT_BLOCK	(256*1024)
+
+/** @brief A sorted run being merged */
+struct run{
+	/** @brief Offset of the next block in the file */
+	off_t pos;
+	/** @brief End of the run in the file */
+	off_t stop;
+	/** @brief Block read from the run */
+	char *buf;
+	/** @brief Next record, NULL once the run is exhausted */
+	char *cur;
+	char *end;
+};
+
+/** @brief Internal function reading until len bytes or end of file
+ *
+ * @return	Bytes read, -1 on error
+ */
+static ssize_t read_full(int fd,char *buf,size_t len)
+{
+	size_t done=0;
+	while(done<len){
+		ssize_t r=read(fd,buf+done,len-done);
+		if(r==0){
+			break;
+		}
+		if(r<0){
+			if(errno==EINTR){
+				continue;
+			}
+			return -1;
+		}
+		done+=(size_t)r;
+	}
+	return (ssize_t)done;
+}
+
+/** @brief Internal function writing all of a buffer
+ *
+ * @return	0 on success, -1 on error
+ */
+static int write_full(int fd,const char *buf,size_t len)
+{
+	while(len>0){
+		ssize_t w=write(fd,buf,len);
+		if(w<0){
+			if(errno==EINTR){
+				continue;
+			}
+			return -1;
+		}
+		buf+=w;
+		len-=(size_t)w;
+	}
+	return 0;
+}
+
+/** @brief Internal function creating an anonymous temporary file
+ *
+ * The file is unlinked at once and lives as long as its descriptor.
+ *
+ * @return	The descriptor, -1 on error
+ */
+static int make_temp(const char *dir)
+{
+	char path[PATH_MAX];
+	int fd;
+	if(snprintf(path,sizeof(path),"%s/gsort.XXXXXX",dir)>=(int)sizeof(path)){
+		errno=ENAMETOOLONG;
+		return -1;
+	}
+	fd=mkstemp(path);
+	if(fd>=0){
+		unlink(path);
+	}
+	return fd;
+}
+
+/** @brief Internal function reading the next block of a run
+ *
+ * @return	0 on success, -1 on error
+ */
+static int refill(int fd,struct run *r,size_t block)
+{
+	size_t len=r->stop-r->pos<(off_t)block?(size_t)(r->stop-r->pos):block,done=0;
+	while(done<len){
+		ssize_t got=pread(fd,r->buf+done,len-done,r->pos+(off_t)done);
+		if(got<=0){
+			if(got<0&&errno==EINTR){
+				continue;
+			}
+			if(got==0){
+				errno=EIO;
+			}
+			return -1;
+		}
+		done+=(size_t)got;
+	}
+	r->pos+=(off_t)len;
+	r->cur=len>0?r->buf:NULL;
+	r->end=r->buf+len;
+	return 0;
+}
+
+/** @brief Internal function telling whether run a goes before run b
+ *
+ * Exhausted runs go after everything and ties go to the earlier run,
+ * which keeps the merge stable.
+ */
+static int run_before(const void *inputs,size_t a,size_t b,cmpfunc_t cmp)
+{
+	const struct run *runs=(const struct run*)inputs;
+	int c;
+	if(runs[a].cur==NULL){
+		return runs[b].cur==NULL&&a<b;
+	}
+	if(runs[b].cur==NULL){
+		return 1;
+	}
+	c=cmp(runs[a].cur,runs[b].cur);
+	return c<0||(c==0&&a<b);
+}
+
+/** @brief Internal function merging k runs of a file into out_fd
+ *
+ * @param fd:	File holding the runs
+ * @param bounds:	Run i spans [bounds[i],bounds[i+1]) in the file
+ * @param mem:	Room for k+1 blocks, the last one buffers the output
+ * @param block:	Bytes per block, a multiple of sz
+ * @param runs:	Room for k runs
+ * @param tree:	Room for 3k indices
+ *
+ * @return	0 on success, G_EIO on error
+ */
+static int merge_runs(int fd,const off_t *bounds,size_t k,int out_fd,size_t sz,cmpfunc_t cmp,char *mem,size_t block,struct run *runs,size_t *tree)
+{
+	char *out=mem+k*block;
+	size_t used=0,i;
+	for(i=0;i<k;i++){
+		runs[i].pos=bounds[i];
+		runs[i].stop=bounds[i+1];
+		runs[i].buf=mem+i*block;
+		if(refill(fd,&runs[i],block)<0){
+			return G_EIO;
+		}
+	}
+	loser_tree_init(tree,tree+k,k,run_before,runs,cmp);
+	while(runs[tree[0]].cur!=NULL){
+		struct run *r=&runs[tree[0]];
+		memcpy(out+used,r->cur,sz);
+		used+=sz;
+		if(used==block){
+			if(write_full(out_fd,out,used)<0){
+				return G_EIO;
+			}
+			used=0;
+		}
+		r->cur+=sz;
+		if(r->cur==r->end&&refill(fd,r,block)<0){
+			return G_EIO;
+		}
+		loser_tree_replay(tree,k,run_before,runs,cmp);
+	}
+	if(write_full(out_fd,out,used)<0){
+		return G_EIO;
+	}
+	return 0;
+}
+
+int gExternalSort(int in_fd,int out_fd,size_t elem_sz,cmpfunc_t cmpfunc,size_t mem_budget,const char *tmp_dir)
+{
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	size_t chunk_sz,nruns=0,cap=0,fan_in,kmax,block,i;
+	int spill=-1,spare=-1,status=0;
+	off_t *bounds=NULL;
+	char *chunk=NULL,*mem=NULL;
+	struct run *runs=NULL;
+	size_t *tree=NULL;
+	if(mem_budget/elem_sz<4){
+		gErrorCode=G_EINVAL;
+		return G_EINVAL;
+	}
+	if(tmp_dir==NULL){
+		tmp_dir=getenv("TMPDIR");
+		if(tmp_dir==NULL||*tmp_dir=='\0'){
+			tmp_dir="/tmp";
+		}
+	}
+	// gTimSort takes up to half a chunk of scratch memory on top
+	chunk_sz=mem_budget/elem_sz/3*2*elem_sz;
+	chunk=malloc(chunk_sz);
+	if(chunk==NULL){
+		status=G_ENOMEN;
+		goto done;
+	}
+	posix_fadvise(in_fd,0,0,POSIX_FADV_SEQUENTIAL);
+	for(;;){
+		ssize_t got=read_full(in_fd,chunk,chunk_sz);
+		if(got<0){
+			status=G_EIO;
+			goto done;
+		}
+		if((size_t)got%elem_sz!=0){
+			status=G_EINVAL;
+			goto done;
+		}
+		if(got>0&&gTimSort(chunk,(size_t)got/elem_sz,elem_sz,cmpfunc)==NULL){
+			status=G_ENOMEN;
+			goto done;
+		}
+		if(nruns==0&&(size_t)got<chunk_sz){
+			// It all fit in memory
+			if(write_full(out_fd,chunk,(size_t)got)<0){
+				status=G_EIO;
+			}
+			goto done;
+		}
+		if(got==0){
+			break;
+		}
+		// All the runs go one after the other in a single file
+		if(spill<0&&(spill=make_temp(tmp_dir))<0){
+			status=G_EIO;
+			goto done;
+		}
+		if(nruns+1>=cap){
+			off_t *grown=realloc(bounds,(cap?cap*2:16)*sizeof(off_t));
+			if(grown==NULL){
+				status=G_ENOMEN;
+				goto done;
+			}
+			bounds=grown;
+			if(cap==0){
+				bounds[0]=0;
+			}
+			cap=cap?cap*2:16;
+		}
+		if(write_full(spill,chunk,(size_t)got)<0){
+			status=G_EIO;
+			goto done;
+		}
+		bounds[nruns+1]=bounds[nruns]+(off_t)got;
+		nruns++;
+		if((size_t)got<chunk_sz){
+			break;
+		}
+	}
+	free(chunk);
+	chunk=NULL;
+	// One block per run and one for the output
+	block=EXTSORT_BLOCK/elem_sz*elem_sz;
+	if(block==0){
+		block=elem_sz;
+	}
+	fan_in=mem_budget/block>3?mem_budget/block-1:2;
+	kmax=nruns<fan_in?nruns:fan_in;
+	block=mem_budget/(kmax+1)/elem_sz*elem_sz;
+	mem=malloc((kmax+1)*block);
+	runs=malloc(kmax*sizeof(struct run));
+	tree=malloc(3*kmax*sizeof(size_t));
+	if(mem==NULL||runs==NULL||tree==NULL){
+		status=G_ENOMEN;
+		goto done;
+	}
+	// Merge consecutive groups into a second file, so earlier records
+	// stay first on ties, then swap the files
+	while(nruns>fan_in){
+		size_t next=0;
+		int swap;
+		if(spare<0&&(spare=make_temp(tmp_dir))<0){
+			status=G_EIO;
+			goto done;
+		}
+		if(ftruncate(spare,0)<0||lseek(spare,0,SEEK_SET)<0){
+			status=G_EIO;
+			goto done;
+		}
+		for(i=0;i<nruns;i+=fan_in){
+			size_t k=nruns-i<fan_in?nruns-i:fan_in;
+			off_t stop=bounds[i+k];
+			status=merge_runs(spill,bounds+i,k,spare,elem_sz,cmpfunc,mem,block,runs,tree);
+			if(status!=0){
+				goto done;
+			}
+			// The merged run has the same end as its last input
+			bounds[++next]=stop;
+		}
+		nruns=next;
+		swap=spill;
+		spill=spare;
+		spare=swap;
+	}
+	status=merge_runs(spill,bounds,nruns,out_fd,elem_sz,cmpfunc,mem,block,runs,tree);
+done:
+	if(spill>=0){
+		close(spill);
+	}
+	if(spare>=0){
+		close(spare);
+	}
+	free(bounds);
+	free(chunk);
+	free(mem);
+	free(runs);
+	free(tree);
+	if(status!=0){
+		gErrorCode=status;
+	}
+	return status;
+}
+/** @} */
@@ -0,0 +1,85 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+/**
+ * @file	losertree.h
+ *
+ * @brief	Loser tree shared by the k-way merges, not part of the API
+ *
+ * The inputs are indices 0..k-1. The caller says which of two inputs
+ * goes first with a before function, which also decides how exhausted
+ * inputs and ties are ordered. Internal node x has children 2x and 2x+1,
+ * input i is leaf k+i. Every internal node keeps the loser of the match
+ * played there and tree[0] the overall winner.
+ */
+#ifndef	ALGORITHM_LOSERTREE_H
+#define	ALGORITHM_LOSERTREE_H
+#include <stddef.h>	// size_t
+#include <generic.h>
+
+/** @brief Tells whether input a goes before input b */
+typedef int (*loser_before_t)(const void *inputs,size_t a,size_t b,cmpfunc_t cmp);
+
+/** @brief Internal function building a loser tree over k inputs
+ *
+ * @param tree:	Room for k indices
+ * @param win:	Scratch room for 2k indices
+ */
+static inline void loser_tree_init(size_t *tree,size_t *win,size_t k,loser_before_t before,const void *inputs,cmpfunc_t cmp)
+{
+	size_t x;
+	for(x=0;x<k;x++){
+		win[k+x]=x;
+	}
+	for(x=k-1;x>0;x--){
+		size_t a=win[2*x],b=win[2*x+1];
+		if(before(inputs,a,b,cmp)){
+			win[x]=a;
+			tree[x]=b;
+		}else{
+			win[x]=b;
+			tree[x]=a;
+		}
+	}
+	tree[0]=win[1];
+}
+
+/** @brief Internal function finding the new winner once the head of the
+ * winning input changed
+ *
+ * Only the matches on the path from its leaf to the root are replayed,
+ * log k comparisons.
+ */
+static inline void loser_tree_replay(size_t *tree,size_t k,loser_before_t before,const void *inputs,cmpfunc_t cmp)
+{
+	size_t w=tree[0],x;
+	for(x=(w+k)/2;x>0;x/=2){
+		if(before(inputs,tree[x],w,cmp)){
+			size_t t=tree[x];
+			tree[x]=w;
+			w=t;
+		}
+	}
+	tree[0]=w;
+}
+#endif	// ALGORITHM_LOSERTREE_H
@@ -0,0 +1,128 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/algorithm/mergek.h>
+#include "losertree.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+/** @addtogroup mergek
+ * @{
+ */
+
+/** @brief Most inputs merged without allocating the tree */
+#define	MERGEK_STACK	64
+
+/** @brief Remaining part of an input */
+struct source{
+	const char *cur;
+	const char *end;
+};
+
+/** @brief Internal function telling whether input a goes before input b
+ *
+ * Exhausted inputs go after everything and ties go to the earlier input,
+ * which keeps the merge stable.
+ */
+static int source_before(const void *inputs,size_t a,size_t b,cmpfunc_t cmp)
+{
+	const struct source *src=(const struct source*)inputs;
+	int c;
+	if(src[a].cur==src[a].end){
+		return src[b].cur==src[b].end&&a<b;
+	}
+	if(src[b].cur==src[b].end){
+		return 1;
+	}
+	c=cmp((void*)src[a].cur,(void*)src[b].cur);
+	return c<0||(c==0&&a<b);
+}
+
+void *gMergeK(void *const inputs[],const size_t counts[],size_t k,size_t elem_sz,cmpfunc_t cmpfunc,void *out)
+{
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	struct source stack_src[MERGEK_STACK],*src=stack_src;
+	size_t stack_tree[3*MERGEK_STACK],*tree=stack_tree;
+	size_t active=0,i;
+	char *dst=(char*)out;
+	if(k==0){
+		return out;
+	}
+	if(k>MERGEK_STACK){
+		src=malloc(k*sizeof(struct source));
+		tree=malloc(3*k*sizeof(size_t));
+		if(src==NULL||tree==NULL){
+			free(src);
+			free(tree);
+			gErrorCode=G_ENOMEN;
+			return NULL;
+		}
+	}
+	for(i=0;i<k;i++){
+		src[i].cur=(const char*)inputs[i];
+		src[i].end=src[i].cur+counts[i]*elem_sz;
+		active+=counts[i]>0;
+	}
+	loser_tree_init(tree,tree+k,k,source_before,src,cmpfunc);
+	while(active>1){
+		struct source *s=&src[tree[0]];
+		memcpy(dst,s->cur,elem_sz);
+		dst+=elem_sz;
+		s->cur+=elem_sz;
+		if(s->cur==s->end){
+			active--;
+		}
+		loser_tree_replay(tree,k,source_before,src,cmpfunc);
+	}
+	// Exhausted inputs lose every match, so the last one is the winner
+	if(active==1){
+		struct source *s=&src[tree[0]];
+		memcpy(dst,s->cur,s->end-s->cur);
+	}
+	if(src!=stack_src){
+		free(src);
+		free(tree);
+	}
+	return out;
+}
+
+int gMergeKVector(void *const inputs[],const size_t counts[],size_t k,cmpfunc_t cmpfunc,gVector *out)
+{
+	assert(out!=NULL);
+	size_t old=out->n,total=0,i;
+	for(i=0;i<k;i++){
+		total+=counts[i];
+	}
+	gVectorResize(out,old+total);
+	if(out->n!=old+total){
+		return G_ENOMEN;
+	}
+	if(gMergeK(inputs,counts,k,out->elem_sz,cmpfunc,gVectorItemAt(out,old))==NULL){
+		gVectorResize(out,old);
+		return G_ENOMEN;
+	}
+	return 0;
+}
+/** @} */
@@ -23,118 +23,379 @@
  */
 
 #include <generic/algorithm/mergesort.h>
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
 /** @addtogroup mergesort
  * @{
  */
 
-/** @brief Internal function that does merging
- *
- * It helps merge two sublists
+/** @brief Length of the runs sorted by insertion sort before merging */
+#define	MERGESORT_RUN	16
+/** @brief Fewest elements per thread of the parallel sort */
+#define	PARALLEL_CUTOFF	(1<<16)
+
+/** @brief Internal function sorting a short run by insertion
  *
- * @param arr:	Array containing the sublists
- * @param beg:	Start of first sublist
- * @param mid:	End of first sublist
- * @param end:	End of second sublist
+ * @param arr:	Start of the run
+ * @param n:	Length of the run
  */
-static void do_merge(int *arr,size_t beg,size_t mid,size_t end)
+static void insertion_sort(int *arr,size_t n)
 {
-	int tmp[end-beg+1];
-	size_t i=beg,j=mid+1,k=0;
-	// Move the smaller number to the new array
-	while(i<=mid&&j<=end){
-		if(arr[i]<arr[j]){
-			tmp[k++]=arr[i++];
-		}else{
-			tmp[k++]=arr[j++];
+	size_t i,j;
+	for(i=1;i<n;i++){
+		int x=arr[i];
+		for(j=i;j>0&&arr[j-1]>x;j--){
+			arr[j]=arr[j-1];
 		}
+		arr[j]=x;
 	}
-	// Move the remaining of the left block
-	while(i<=mid){
-		tmp[k++]=arr[i++];
+}
+
+/** @brief Internal function that does merging
+ *
+ * Merges src[beg,mid) and src[mid,end) into dst[beg,end), taking the
+ * left element on ties. Runs already in order are copied as they are.
+ */
+static void do_merge(const int *src,int *dst,size_t beg,size_t mid,size_t end)
+{
+	size_t i=beg,j=mid,k=beg;
+	if(mid>=end||src[mid-1]<=src[mid]){
+		memcpy(dst+beg,src+beg,(end-beg)*sizeof(int));
+		return;
 	}
-	// Move the remaining of the right block
-	while(j<=end){
-		tmp[k++]=arr[j++];
+	while(i<mid&&j<end){
+		dst[k++]=src[j]<src[i]?src[j++]:src[i++];
 	}
-	memcpy(arr+beg,tmp,sizeof(tmp));
+	memcpy(dst+k,src+i,(mid-i)*sizeof(int));
+	memcpy(dst+k+(mid-i),src+j,(end-j)*sizeof(int));
 }
 
-/** @brief Internal function that splits the list
+int *mergeSort(int *arr,size_t n)
+{
+	size_t beg,width;
+	if(n<2){
+		return arr;
+	}
+	if(n<=MERGESORT_RUN){
+		insertion_sort(arr,n);
+		return arr;
+	}
+	int *tmp=malloc(n*sizeof(int));
+	if(tmp==NULL){
+		gErrorCode=G_ENOMEN;
+		return NULL;
+	}
+	for(beg=0;beg<n;beg+=MERGESORT_RUN){
+		insertion_sort(arr+beg,n-beg<MERGESORT_RUN?n-beg:MERGESORT_RUN);
+	}
+	// Every level merges from one buffer into the other
+	int *src=arr,*dst=tmp,*swap;
+	for(width=MERGESORT_RUN;width<n;width*=2){
+		for(beg=0;beg<n;beg+=2*width){
+			size_t mid=beg+width<n?beg+width:n;
+			size_t end=beg+2*width<n?beg+2*width:n;
+			do_merge(src,dst,beg,mid,end);
+		}
+		swap=src;
+		src=dst;
+		dst=swap;
+	}
+	if(src!=arr){
+		memcpy(arr,src,n*sizeof(int));
+	}
+	free(tmp);
+	return arr;
+}
+
+/** @brief Internal function sorting a short run of generic elements by insertion
  *
- * It is called recursively in order to split everything to the smallest
+ * @param arr:	Start of the run
+ * @param n:	Length of the run
+ * @param elem_sz:	Size of each element
+ * @param cmpfunc:	Function for comparing the elements
+ * @param tmp:	Room for one element
+ */
+static void insertion_sort_generic(char *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,char *tmp)
+{
+	size_t i,j;
+	for(i=1;i<n;i++){
+		if(cmpfunc(arr+(i-1)*elem_sz,arr+i*elem_sz)<=0){
+			continue;
+		}
+		memcpy(tmp,arr+i*elem_sz,elem_sz);
+		for(j=i;j>0&&cmpfunc(arr+(j-1)*elem_sz,tmp)>0;j--);
+		memmove(arr+(j+1)*elem_sz,arr+j*elem_sz,(i-j)*elem_sz);
+		memcpy(arr+j*elem_sz,tmp,elem_sz);
+	}
+}
+
+/** @brief Internal function that merges generic elements
  *
- * @param arr:	Array being splited
- * @param beg:	Begin of the section
- * @param end:	End of the section
+ * Same as do_merge, with sizes in elements
  */
-static void do_split(int *arr,size_t beg,size_t end)
+static void do_merge_generic(const char *src,char *dst,size_t beg,size_t mid,size_t end,size_t elem_sz,cmpfunc_t cmpfunc)
 {
-	if(end-beg<1){
+	const char *i=src+beg*elem_sz,*j=src+mid*elem_sz;
+	const char *iend=j,*jend=src+end*elem_sz;
+	char *k=dst+beg*elem_sz;
+	if(mid>=end||cmpfunc((void*)(j-elem_sz),(void*)j)<=0){
+		memcpy(k,i,(end-beg)*elem_sz);
 		return;
 	}
-	size_t mid=(beg+end)/2;
-	do_split(arr,beg,mid);
-	do_split(arr,mid+1,end);
-	do_merge(arr,beg,mid,end);
+	while(i<iend&&j<jend){
+		if(cmpfunc((void*)j,(void*)i)<0){
+			memcpy(k,j,elem_sz);
+			j+=elem_sz;
+		}else{
+			memcpy(k,i,elem_sz);
+			i+=elem_sz;
+		}
+		k+=elem_sz;
+	}
+	memcpy(k,i,iend-i);
+	memcpy(k+(iend-i),j,jend-j);
 }
 
-int *mergeSort(int *arr,size_t n)
+/** @brief Internal function sorting generic elements with a given scratch buffer
+ *
+ * @param tmp:	Room for n elements
+ */
+static void sort_generic(char *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,char *tmp)
+{
+	size_t beg,width;
+	for(beg=0;beg<n;beg+=MERGESORT_RUN){
+		insertion_sort_generic(arr+beg*elem_sz,n-beg<MERGESORT_RUN?n-beg:MERGESORT_RUN,elem_sz,cmpfunc,tmp);
+	}
+	char *src=arr,*dst=tmp,*swap;
+	for(width=MERGESORT_RUN;width<n;width*=2){
+		for(beg=0;beg<n;beg+=2*width){
+			size_t mid=beg+width<n?beg+width:n;
+			size_t end=beg+2*width<n?beg+2*width:n;
+			do_merge_generic(src,dst,beg,mid,end,elem_sz,cmpfunc);
+		}
+		swap=src;
+		src=dst;
+		dst=swap;
+	}
+	if(src!=arr){
+		memcpy(arr,src,n*elem_sz);
+	}
+}
+
+void *gMergeSort(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc)
 {
-	assert(n>1);
-	do_split(arr,0,n-1);
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	if(n<2){
+		return arr;
+	}
+	char *tmp=malloc(n*elem_sz);
+	if(tmp==NULL){
+		gErrorCode=G_ENOMEN;
+		return NULL;
+	}
+	sort_generic((char*)arr,n,elem_sz,cmpfunc,tmp);
+	free(tmp);
 	return arr;
 }
 
-static void do_merge_generic(char *arr,size_t beg,size_t mid,size_t end,size_t elem_sz,cmpfunc_t cmpfunc)
+/** @brief Work given to one thread of the parallel sort
+ *
+ * In the first phase a thread sorts the chunk [beg,end) of arr. In the
+ * following ones it writes the part [beg,end) of the output of a merge
+ * level, whichever pairs of runs it falls in.
+ */
+struct parallel_task{
+	char *src;
+	char *dst;
+	size_t elem_sz;
+	cmpfunc_t cmpfunc;
+	/** @brief Boundaries of the runs being merged, nruns+1 of them */
+	const size_t *bounds;
+	size_t nruns;
+	size_t beg;
+	size_t end;
+	/** @brief Whether a thread was started for the task, see run_tasks */
+	int started;
+};
+
+/** @brief Internal function merging two sorted arrays into dst
+ *
+ * Ties take the element of a, keeping the merge stable.
+ */
+static void merge_into(const char *a,size_t na,const char *b,size_t nb,char *dst,size_t elem_sz,cmpfunc_t cmpfunc)
 {
-	char tmp[elem_sz*(end-beg+1)];
-	size_t i=beg,j=mid+1,k=0;
-	int ret=0;
-	while(i<=mid&&j<=end){
-		ret=cmpfunc(arr+i*elem_sz,arr+j*elem_sz);
-		if(ret<0){
-			memcpy(tmp+k*elem_sz,arr+i*elem_sz,elem_sz);
-			k++;
-			i++;
+	const char *aend=a+na*elem_sz,*bend=b+nb*elem_sz;
+	while(a<aend&&b<bend){
+		if(cmpfunc((void*)b,(void*)a)<0){
+			memcpy(dst,b,elem_sz);
+			b+=elem_sz;
 		}else{
-			memcpy(tmp+k*elem_sz,arr+j*elem_sz,elem_sz);
-			k++;
-			j++;
+			memcpy(dst,a,elem_sz);
+			a+=elem_sz;
 		}
+		dst+=elem_sz;
 	}
-	while(i<=mid){
-		memcpy(tmp+k*elem_sz,arr+i*elem_sz,elem_sz);
-		k++;
-		i++;
+	memcpy(dst,a,aend-a);
+	memcpy(dst+(aend-a),b,bend-b);
+}
+
+/** @brief Internal function finding where the merge of a and b is cut
+ *
+ * Co-ranking, or merge path: the first k elements of the stable merge of
+ * a and b are a[0,i) and b[0,k-i).
+ *
+ * @return	i
+ */
+static size_t co_rank(size_t k,const char *a,size_t na,const char *b,size_t nb,size_t elem_sz,cmpfunc_t cmpfunc)
+{
+	size_t lo=k>nb?k-nb:0;
+	size_t hi=k<na?k:na;
+	while(lo<hi){
+		size_t i=lo+(hi-lo)/2;
+		// b[k-i-1] goes before a[i] only if strictly smaller
+		if(cmpfunc((void*)(b+(k-i-1)*elem_sz),(void*)(a+i*elem_sz))<0){
+			hi=i;
+		}else{
+			lo=i+1;
+		}
 	}
-	while(j<=end){
-		memcpy(tmp+k*elem_sz,arr+j*elem_sz,elem_sz);
-		k++;
-		j++;
+	return lo;
+}
+
+/** @brief Internal thread function sorting a chunk */
+static void *sort_chunk(void *arg)
+{
+	struct parallel_task *t=(struct parallel_task*)arg;
+	sort_generic(t->src+t->beg*t->elem_sz,t->end-t->beg,t->elem_sz,t->cmpfunc,t->dst+t->beg*t->elem_sz);
+	return NULL;
+}
+
+/** @brief Internal thread function writing its part of a merge level */
+static void *merge_part(void *arg)
+{
+	struct parallel_task *t=(struct parallel_task*)arg;
+	size_t sz=t->elem_sz;
+	size_t r;
+	for(r=0;r<t->nruns;r+=2){
+		size_t beg=t->bounds[r];
+		size_t mid=t->bounds[r+1];
+		size_t end=r+2<=t->nruns?t->bounds[r+2]:mid;
+		size_t k0,k1,i0,i1;
+		if(end<=t->beg||beg>=t->end){
+			continue;
+		}
+		k0=(t->beg>beg?t->beg:beg)-beg;
+		k1=(t->end<end?t->end:end)-beg;
+		i0=co_rank(k0,t->src+beg*sz,mid-beg,t->src+mid*sz,end-mid,sz,t->cmpfunc);
+		i1=co_rank(k1,t->src+beg*sz,mid-beg,t->src+mid*sz,end-mid,sz,t->cmpfunc);
+		merge_into(t->src+(beg+i0)*sz,i1-i0,t->src+(mid+k0-i0)*sz,(k1-i1)-(k0-i0),
+			   t->dst+(beg+k0)*sz,sz,t->cmpfunc);
 	}
-	memcpy(arr+beg*elem_sz,tmp,sizeof(tmp));
+	return NULL;
 }
 
-static void do_split_generic(void *arr,size_t beg,size_t end,size_t elem_sz,cmpfunc_t cmpfunc)
+/** @brief Internal function running one task per thread and waiting for them
+ *
+ * A task whose thread could not be started runs in the calling thread.
+ */
+static void run_tasks(struct parallel_task *tasks,pthread_t *threads,unsigned int n,void *(*fn)(void*))
 {
-	if(end-beg<=1){
-		return;
+	unsigned int i;
+	for(i=1;i<n;i++){
+		tasks[i].started=pthread_create(&threads[i],NULL,fn,&tasks[i])==0;
+	}
+	fn(&tasks[0]);
+	for(i=1;i<n;i++){
+		if(tasks[i].started){
+			pthread_join(threads[i],NULL);
+		}else{
+			fn(&tasks[i]);
+		}
 	}
-	size_t mid=(beg+end)/2;
-	do_split_generic((char*)arr,beg,mid,elem_sz,cmpfunc);
-	do_split_generic((char*)arr,mid+1,end,elem_sz,cmpfunc);
-	do_merge_generic((char*)arr,beg,mid,end,elem_sz,cmpfunc);
 }
 
-void *gMergeSort(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc)
+void *gParallelMergeSort(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,unsigned int nthreads)
 {
 	assert(cmpfunc!=NULL);
 	assert(elem_sz>0);
-	assert(n>1);
-	do_split_generic(arr,0,n-1,elem_sz,cmpfunc);
+	struct parallel_task *tasks;
+	pthread_t *threads;
+	size_t *bounds;
+	char *tmp,*src,*dst,*swap;
+	size_t nruns,r;
+	unsigned int i;
+	if(nthreads==0){
+		long online=sysconf(_SC_NPROCESSORS_ONLN);
+		nthreads=online>0?(unsigned int)online:1;
+	}
+	// Below the cutoff threads cost more than they save
+	if(n/PARALLEL_CUTOFF<nthreads){
+		nthreads=(unsigned int)(n/PARALLEL_CUTOFF);
+	}
+	if(nthreads<=1){
+		return gMergeSort(arr,n,elem_sz,cmpfunc);
+	}
+	tmp=malloc(n*elem_sz);
+	tasks=malloc(nthreads*sizeof(struct parallel_task));
+	threads=malloc(nthreads*sizeof(pthread_t));
+	bounds=malloc((nthreads+1)*sizeof(size_t));
+	if(tmp==NULL||tasks==NULL||threads==NULL||bounds==NULL){
+		free(tmp);
+		free(tasks);
+		free(threads);
+		free(bounds);
+		gErrorCode=G_ENOMEN;
+		return NULL;
+	}
+	for(i=0;i<nthreads;i++){
+		tasks[i].src=(char*)arr;
+		tasks[i].dst=tmp;
+		tasks[i].elem_sz=elem_sz;
+		tasks[i].cmpfunc=cmpfunc;
+		tasks[i].bounds=bounds;
+		tasks[i].beg=n/nthreads*i;
+		tasks[i].end=i+1<nthreads?n/nthreads*(i+1):n;
+		bounds[i]=tasks[i].beg;
+	}
+	bounds[nthreads]=n;
+	nruns=nthreads;
+	run_tasks(tasks,threads,nthreads,sort_chunk);
+	// Every level merges pairs of runs, the output is split evenly between the threads
+	src=(char*)arr;
+	dst=tmp;
+	while(nruns>1){
+		for(i=0;i<nthreads;i++){
+			tasks[i].src=src;
+			tasks[i].dst=dst;
+			tasks[i].nruns=nruns;
+		}
+		run_tasks(tasks,threads,nthreads,merge_part);
+		for(r=0;2*r<=nruns;r++){
+			bounds[r]=bounds[2*r<nruns?2*r:nruns];
+		}
+		nruns=(nruns+1)/2;
+		bounds[nruns]=n;
+		swap=src;
+		src=dst;
+		dst=swap;
+	}
+	if(src!=(char*)arr){
+		for(i=0;i<nthreads;i++){
+			tasks[i].src=src;
+			tasks[i].dst=(char*)arr;
+			tasks[i].nruns=1;
+		}
+		// A single run is copied by merge_part
+		run_tasks(tasks,threads,nthreads,merge_part);
+	}
+	free(tmp);
+	free(tasks);
+	free(threads);
+	free(bounds);
 	return arr;
 }
 /** @} */
-
@@ -0,0 +1,478 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/algorithm/pdqsort.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+/** @addtogroup pdqsort
+ * @{
+ */
+
+/** @brief Ranges shorter than this are insertion sorted */
+#define	INSERTION_SORT_THRESHOLD	24
+/** @brief Ranges longer than this use a ninther as pivot */
+#define	NINTHER_THRESHOLD	128
+/** @brief Moves allowed to a partial insertion sort before it gives up */
+#define	PARTIAL_INSERTION_SORT_LIMIT	8
+/** @brief Elements compared per block by the partition, offsets fit a byte */
+#define	BLOCK_SIZE	64
+
+/** @brief State shared by the internal functions */
+struct sort_ctx{
+	size_t sz;
+	cmpfunc_t cmp;
+	/** @brief Room for one element */
+	char *tmp;
+};
+
+#define	LESS(c,a,b)	((c)->cmp((void*)(a),(void*)(b))<0)
+
+/** @brief Internal function swapping two elements a word at a time */
+static void swap_elem(char *a,char *b,size_t sz)
+{
+	uint64_t x,y;
+	uint32_t u,v;
+	char t;
+	while(sz>=sizeof(x)){
+		memcpy(&x,a,sizeof(x));
+		memcpy(&y,b,sizeof(y));
+		memcpy(a,&y,sizeof(y));
+		memcpy(b,&x,sizeof(x));
+		a+=sizeof(x);
+		b+=sizeof(x);
+		sz-=sizeof(x);
+	}
+	if(sz>=sizeof(u)){
+		memcpy(&u,a,sizeof(u));
+		memcpy(&v,b,sizeof(v));
+		memcpy(a,&v,sizeof(v));
+		memcpy(b,&u,sizeof(u));
+		a+=sizeof(u);
+		b+=sizeof(u);
+		sz-=sizeof(u);
+	}
+	while(sz--){
+		t=*a;
+		*a++=*b;
+		*b++=t;
+	}
+}
+
+/** @brief Internal function sorting [begin,end) by insertion */
+static void insertion_sort(struct sort_ctx *c,char *begin,char *end)
+{
+	size_t sz=c->sz;
+	char *cur,*sift;
+	if(begin==end){
+		return;
+	}
+	for(cur=begin+sz;cur<end;cur+=sz){
+		sift=cur;
+		if(LESS(c,sift,sift-sz)){
+			memcpy(c->tmp,sift,sz);
+			do{
+				memcpy(sift,sift-sz,sz);
+				sift-=sz;
+			}while(sift!=begin&&LESS(c,c->tmp,sift-sz));
+			memcpy(sift,c->tmp,sz);
+		}
+	}
+}
+
+/** @brief Internal function sorting [begin,end) by insertion, knowing
+ * that the element before begin is not greater than any of them
+ */
+static void unguarded_insertion_sort(struct sort_ctx *c,char *begin,char *end)
+{
+	size_t sz=c->sz;
+	char *cur,*sift;
+	if(begin==end){
+		return;
+	}
+	for(cur=begin+sz;cur<end;cur+=sz){
+		sift=cur;
+		if(LESS(c,sift,sift-sz)){
+			memcpy(c->tmp,sift,sz);
+			do{
+				memcpy(sift,sift-sz,sz);
+				sift-=sz;
+			}while(LESS(c,c->tmp,sift-sz));
+			memcpy(sift,c->tmp,sz);
+		}
+	}
+}
+
+/** @brief Internal function trying to sort [begin,end) by insertion
+ *
+ * @return	1 if sorted, 0 if it gave up after
+ *		PARTIAL_INSERTION_SORT_LIMIT moves
+ */
+static int partial_insertion_sort(struct sort_ctx *c,char *begin,char *end)
+{
+	size_t sz=c->sz;
+	size_t limit=0;
+	char *cur,*sift;
+	if(begin==end){
+		return 1;
+	}
+	for(cur=begin+sz;cur<end;cur+=sz){
+		sift=cur;
+		if(LESS(c,sift,sift-sz)){
+			memcpy(c->tmp,sift,sz);
+			do{
+				memcpy(sift,sift-sz,sz);
+				sift-=sz;
+			}while(sift!=begin&&LESS(c,c->tmp,sift-sz));
+			memcpy(sift,c->tmp,sz);
+			limit+=(size_t)(cur-sift)/sz;
+		}
+		if(limit>PARTIAL_INSERTION_SORT_LIMIT){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static void sort2(struct sort_ctx *c,char *a,char *b)
+{
+	if(LESS(c,b,a)){
+		swap_elem(a,b,c->sz);
+	}
+}
+
+static void sort3(struct sort_ctx *c,char *a,char *b,char *d)
+{
+	sort2(c,a,b);
+	sort2(c,b,d);
+	sort2(c,a,b);
+}
+
+/** @brief Internal function sifting an element down a max-heap */
+static void sift_down(struct sort_ctx *c,char *base,size_t root,size_t n)
+{
+	size_t sz=c->sz;
+	size_t child;
+	while((child=2*root+1)<n){
+		if(child+1<n&&LESS(c,base+child*sz,base+(child+1)*sz)){
+			child++;
+		}
+		if(!LESS(c,base+root*sz,base+child*sz)){
+			return;
+		}
+		swap_elem(base+root*sz,base+child*sz,sz);
+		root=child;
+	}
+}
+
+/** @brief Internal function sorting [begin,end) by heapsort */
+static void heap_sort(struct sort_ctx *c,char *begin,char *end)
+{
+	size_t sz=c->sz;
+	size_t n=(size_t)(end-begin)/sz;
+	size_t i;
+	for(i=n/2;i-->0;){
+		sift_down(c,begin,i,n);
+	}
+	for(i=n;i-->1;){
+		swap_elem(begin,begin+i*sz,sz);
+		sift_down(c,begin,0,i);
+	}
+}
+
+/** @brief Internal function swapping the elements found on the wrong side */
+static void swap_offsets(struct sort_ctx *c,char *first,char *last,const unsigned char *offsets_l,const unsigned char *offsets_r,size_t num)
+{
+	size_t i;
+	for(i=0;i<num;i++){
+		swap_elem(first+offsets_l[i]*c->sz,last-offsets_r[i]*c->sz,c->sz);
+	}
+}
+
+/** @brief Internal function partitioning around the pivot at begin
+ *
+ * Elements less than the pivot go to its left, the others to its right.
+ * The comparisons are done a block at a time and only record offsets, so
+ * the loop does not branch on their result.
+ *
+ * @param already_partitioned:	Set to 1 if no element had to move
+ *
+ * @return	Final position of the pivot
+ */
+static char *partition_right(struct sort_ctx *c,char *begin,char *end,int *already_partitioned)
+{
+	size_t sz=c->sz;
+	char *pivot=begin;
+	char *first=begin;
+	char *last=end;
+	char *it;
+	size_t i;
+	// The median of 3 left an element not less than the pivot at the end
+	while(LESS(c,first+=sz,pivot));
+	// and one not greater than it before first, unless first is the first element
+	if(first-sz==begin){
+		while(first<last&&!LESS(c,last-=sz,pivot));
+	}else{
+		while(!LESS(c,last-=sz,pivot));
+	}
+	*already_partitioned=first>=last;
+	if(!*already_partitioned){
+		unsigned char offsets_l[BLOCK_SIZE],offsets_r[BLOCK_SIZE];
+		size_t start_l=0,start_r=0,num_l=0,num_r=0,num;
+		size_t l_size,r_size,unknown_left;
+		swap_elem(first,last,sz);
+		first+=sz;
+		while((size_t)(last-first)>2*BLOCK_SIZE*sz){
+			if(num_l==0){
+				start_l=0;
+				it=first;
+				for(i=0;i<BLOCK_SIZE;i++){
+					offsets_l[num_l]=(unsigned char)i;
+					num_l+=!LESS(c,it,pivot);
+					it+=sz;
+				}
+			}
+			if(num_r==0){
+				start_r=0;
+				it=last;
+				for(i=0;i<BLOCK_SIZE;i++){
+					offsets_r[num_r]=(unsigned char)(i+1);
+					num_r+=LESS(c,it-=sz,pivot);
+				}
+			}
+			num=num_l<num_r?num_l:num_r;
+			swap_offsets(c,first,last,offsets_l+start_l,offsets_r+start_r,num);
+			num_l-=num;
+			num_r-=num;
+			start_l+=num;
+			start_r+=num;
+			if(num_l==0){
+				first+=BLOCK_SIZE*sz;
+			}
+			if(num_r==0){
+				last-=BLOCK_SIZE*sz;
+			}
+		}
+		// What is left is less than two blocks, one of which may be pending
+		unknown_left=(size_t)(last-first)/sz-((num_r||num_l)?BLOCK_SIZE:0);
+		if(num_r){
+			l_size=unknown_left;
+			r_size=BLOCK_SIZE;
+		}else if(num_l){
+			l_size=BLOCK_SIZE;
+			r_size=unknown_left;
+		}else{
+			l_size=unknown_left/2;
+			r_size=unknown_left-l_size;
+		}
+		if(unknown_left&&!num_l){
+			start_l=0;
+			it=first;
+			for(i=0;i<l_size;i++){
+				offsets_l[num_l]=(unsigned char)i;
+				num_l+=!LESS(c,it,pivot);
+				it+=sz;
+			}
+		}
+		if(unknown_left&&!num_r){
+			start_r=0;
+			it=last;
+			for(i=0;i<r_size;i++){
+				offsets_r[num_r]=(unsigned char)(i+1);
+				num_r+=LESS(c,it-=sz,pivot);
+			}
+		}
+		num=num_l<num_r?num_l:num_r;
+		swap_offsets(c,first,last,offsets_l+start_l,offsets_r+start_r,num);
+		num_l-=num;
+		num_r-=num;
+		start_l+=num;
+		start_r+=num;
+		if(num_l==0){
+			first+=l_size*sz;
+		}
+		if(num_r==0){
+			last-=r_size*sz;
+		}
+		// Move the elements of the block left over to the middle
+		if(num_l){
+			while(num_l--){
+				swap_elem(first+offsets_l[start_l+num_l]*sz,last-=sz,sz);
+			}
+			first=last;
+		}
+		if(num_r){
+			while(num_r--){
+				swap_elem(last-offsets_r[start_r+num_r]*sz,first,sz);
+				first+=sz;
+			}
+			last=first;
+		}
+	}
+	swap_elem(begin,first-sz,sz);
+	return first-sz;
+}
+
+/** @brief Internal function partitioning around the pivot at begin,
+ * putting the elements equal to it on its left
+ *
+ * Used when the pivot equals the pivot of the parent range, the left part
+ * is then all equal and needs no more sorting.
+ *
+ * @return	Final position of the pivot
+ */
+static char *partition_left(struct sort_ctx *c,char *begin,char *end)
+{
+	size_t sz=c->sz;
+	char *pivot=begin;
+	char *first=begin;
+	char *last=end;
+	while(LESS(c,pivot,last-=sz));
+	if(last+sz==end){
+		while(first<last&&!LESS(c,pivot,first+=sz));
+	}else{
+		while(!LESS(c,pivot,first+=sz));
+	}
+	while(first<last){
+		swap_elem(first,last,sz);
+		while(LESS(c,pivot,last-=sz));
+		while(!LESS(c,pivot,first+=sz));
+	}
+	swap_elem(begin,last,sz);
+	return last;
+}
+
+/** @brief Internal function sorting [begin,end)
+ *
+ * Recurses on the left part and loops on the right one.
+ *
+ * @param bad_allowed:	Unbalanced partitions left before heapsort
+ * @param leftmost:	Whether begin is the start of the whole array,
+ *			otherwise the element before it is a pivot not
+ *			greater than any element of the range
+ */
+static void pdqsort_loop(struct sort_ctx *c,char *begin,char *end,int bad_allowed,int leftmost)
+{
+	size_t sz=c->sz;
+	for(;;){
+		size_t size=(size_t)(end-begin)/sz;
+		size_t s2=size/2;
+		size_t l_size,r_size;
+		int already_partitioned;
+		char *pivot_pos;
+		if(size<INSERTION_SORT_THRESHOLD){
+			if(leftmost){
+				insertion_sort(c,begin,end);
+			}else{
+				unguarded_insertion_sort(c,begin,end);
+			}
+			return;
+		}
+		// Move the chosen pivot to begin
+		if(size>NINTHER_THRESHOLD){
+			sort3(c,begin,begin+s2*sz,end-sz);
+			sort3(c,begin+sz,begin+(s2-1)*sz,end-2*sz);
+			sort3(c,begin+2*sz,begin+(s2+1)*sz,end-3*sz);
+			sort3(c,begin+(s2-1)*sz,begin+s2*sz,begin+(s2+1)*sz);
+			swap_elem(begin,begin+s2*sz,sz);
+		}else{
+			sort3(c,begin+s2*sz,begin,end-sz);
+		}
+		// Equal to the pivot before the range, nothing can be less
+		if(!leftmost&&!LESS(c,begin-sz,begin)){
+			begin=partition_left(c,begin,end)+sz;
+			continue;
+		}
+		pivot_pos=partition_right(c,begin,end,&already_partitioned);
+		l_size=(size_t)(pivot_pos-begin)/sz;
+		r_size=(size_t)(end-(pivot_pos+sz))/sz;
+		if(l_size<size/8||r_size<size/8){
+			if(--bad_allowed==0){
+				heap_sort(c,begin,end);
+				return;
+			}
+			// Swap a few elements around to break the pattern
+			if(l_size>=INSERTION_SORT_THRESHOLD){
+				swap_elem(begin,begin+l_size/4*sz,sz);
+				swap_elem(pivot_pos-sz,pivot_pos-l_size/4*sz,sz);
+				if(l_size>NINTHER_THRESHOLD){
+					swap_elem(begin+sz,begin+(l_size/4+1)*sz,sz);
+					swap_elem(begin+2*sz,begin+(l_size/4+2)*sz,sz);
+					swap_elem(pivot_pos-2*sz,pivot_pos-(l_size/4+1)*sz,sz);
+					swap_elem(pivot_pos-3*sz,pivot_pos-(l_size/4+2)*sz,sz);
+				}
+			}
+			if(r_size>=INSERTION_SORT_THRESHOLD){
+				swap_elem(pivot_pos+sz,pivot_pos+(1+r_size/4)*sz,sz);
+				swap_elem(end-sz,end-r_size/4*sz,sz);
+				if(r_size>NINTHER_THRESHOLD){
+					swap_elem(pivot_pos+2*sz,pivot_pos+(2+r_size/4)*sz,sz);
+					swap_elem(pivot_pos+3*sz,pivot_pos+(3+r_size/4)*sz,sz);
+					swap_elem(end-2*sz,end-(1+r_size/4)*sz,sz);
+					swap_elem(end-3*sz,end-(2+r_size/4)*sz,sz);
+				}
+			}
+		}else if(already_partitioned
+			 &&partial_insertion_sort(c,begin,pivot_pos)
+			 &&partial_insertion_sort(c,pivot_pos+sz,end)){
+			// Probably presorted, and it was
+			return;
+		}
+		pdqsort_loop(c,begin,pivot_pos,bad_allowed,leftmost);
+		begin=pivot_pos+sz;
+		leftmost=0;
+	}
+}
+
+void *gSort(void *base,size_t n,size_t elem_sz,cmpfunc_t cmpfunc)
+{
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	char stack_tmp[GSORT_STACK_ELEM];
+	struct sort_ctx c;
+	int bad_allowed=0;
+	if(n<2){
+		return base;
+	}
+	c.sz=elem_sz;
+	c.cmp=cmpfunc;
+	c.tmp=stack_tmp;
+	if(elem_sz>GSORT_STACK_ELEM){
+		c.tmp=malloc(elem_sz);
+		if(c.tmp==NULL){
+			gErrorCode=G_ENOMEN;
+			return NULL;
+		}
+	}
+	while(n>>bad_allowed){
+		bad_allowed++;
+	}
+	pdqsort_loop(&c,(char*)base,(char*)base+n*elem_sz,bad_allowed,1);
+	if(c.tmp!=stack_tmp){
+		free(c.tmp);
+	}
+	return base;
+}
+/** @} */
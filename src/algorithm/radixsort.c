@@ -0,0 +1,416 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/algorithm/radixsort.h>
+#include <stdlib.h>
+#include <string.h>
+/** @addtogroup radixsort
+ * @{
+ */
+
+/** @brief Digit size of 32 bit keys */
+#define	BITS32	11
+#define	BUCKETS32	(1<<BITS32)
+#define	PASSES32	3
+/** @brief Digit size of 64 bit keys */
+#define	BITS64	8
+#define	BUCKETS64	(1<<BITS64)
+#define	PASSES64	8
+/** @brief Size of the buffer of a bucket, a cache line */
+#define	WC_BYTES	64
+#define	WC32	(WC_BYTES/sizeof(uint32_t))
+#define	WC64	(WC_BYTES/sizeof(uint64_t))
+
+/** @brief Working memory of the 32 bit sort */
+struct radix32_work{
+	size_t hist[PASSES32][BUCKETS32];
+	/** @brief Buffer of each bucket, mirrors the cache line it is written to */
+	uint32_t wc[BUCKETS32][WC32];
+	/** @brief First position of each bucket in the current pass */
+	size_t start[BUCKETS32];
+};
+
+/** @brief Working memory of the 64 bit sort */
+struct radix64_work{
+	size_t hist[PASSES64][BUCKETS64];
+	/** @brief Buffer of each bucket, mirrors the cache line it is written to */
+	uint64_t wc[BUCKETS64][WC64];
+	/** @brief First position of each bucket in the current pass */
+	size_t start[BUCKETS64];
+};
+
+/** @brief Internal function turning counts into the first position of each bucket */
+static void prefix_sums(size_t *hist,size_t buckets)
+{
+	size_t b,sum=0,count;
+	for(b=0;b<buckets;b++){
+		count=hist[b];
+		hist[b]=sum;
+		sum+=count;
+	}
+}
+
+/** @brief Internal function allocating memory aligned on a cache line
+ *
+ * @return	0 on success, G_ENOMEN otherwise
+ */
+static int alloc_lines(void **ptr,size_t size)
+{
+	if(posix_memalign(ptr,WC_BYTES,size>0?size:WC_BYTES)!=0){
+		gErrorCode=G_ENOMEN;
+		return G_ENOMEN;
+	}
+	return 0;
+}
+
+/** @brief Internal function writing the buffer of a bucket to its cache line
+ *
+ * Positions before the bucket start hold keys of the previous bucket and
+ * are not written.
+ *
+ * @param dst:	Destination array
+ * @param wc:	Buffer of the bucket, one cache line of keys
+ * @param start:	First position of the bucket in dst
+ * @param end:	Position after the last key buffered
+ * @param sz:	Size of a key
+ * @param per_line:	Keys per cache line
+ */
+static void flush(void *dst,const void *wc,size_t start,size_t end,size_t sz,size_t per_line)
+{
+	size_t from=(end-1)&~(per_line-1);
+	if(from>=start&&end-from==per_line){
+		// Full line, the common case
+		memcpy((char*)dst+from*sz,wc,WC_BYTES);
+		return;
+	}
+	if(from<start){
+		from=start;
+	}
+	memcpy((char*)dst+from*sz,(const char*)wc+(from&(per_line-1))*sz,(end-from)*sz);
+}
+
+/** @brief Internal function sorting unsigned 32 bit keys
+ *
+ * @return	arr, or NULL if the memory could not be allocated
+ */
+static uint32_t *radix32(uint32_t *arr,size_t n)
+{
+	struct radix32_work *w;
+	uint32_t *tmp,*src=arr,*dst,*swap;
+	size_t i,b;
+	int pass;
+	if(n<2){
+		return arr;
+	}
+	if(alloc_lines((void**)&tmp,n*sizeof(uint32_t))!=0){
+		return NULL;
+	}
+	if(alloc_lines((void**)&w,sizeof(struct radix32_work))!=0){
+		free(tmp);
+		return NULL;
+	}
+	memset(w->hist,0,sizeof(w->hist));
+	dst=tmp;
+	for(i=0;i<n;i++){
+		uint32_t x=arr[i];
+		w->hist[0][x&(BUCKETS32-1)]++;
+		w->hist[1][(x>>BITS32)&(BUCKETS32-1)]++;
+		w->hist[2][x>>(2*BITS32)]++;
+	}
+	for(pass=0;pass<PASSES32;pass++){
+		unsigned int shift=pass*BITS32;
+		size_t *offset=w->hist[pass];
+		// Every key has the same digit, the pass would not move anything
+		if(offset[(src[0]>>shift)&(BUCKETS32-1)]==n){
+			continue;
+		}
+		prefix_sums(offset,BUCKETS32);
+		memcpy(w->start,offset,sizeof(w->start));
+		for(i=0;i<n;i++){
+			uint32_t x=src[i];
+			size_t o;
+			b=(x>>shift)&(BUCKETS32-1);
+			o=offset[b]++;
+			w->wc[b][o&(WC32-1)]=x;
+			if(((o+1)&(WC32-1))==0){
+				flush(dst,w->wc[b],w->start[b],o+1,sizeof(uint32_t),WC32);
+			}
+		}
+		for(b=0;b<BUCKETS32;b++){
+			if(offset[b]&(WC32-1)){
+				flush(dst,w->wc[b],w->start[b],offset[b],sizeof(uint32_t),WC32);
+			}
+		}
+		swap=src;
+		src=dst;
+		dst=swap;
+	}
+	if(src!=arr){
+		memcpy(arr,src,n*sizeof(uint32_t));
+	}
+	free(w);
+	free(tmp);
+	return arr;
+}
+
+/** @brief Internal function sorting unsigned 64 bit keys
+ *
+ * @return	arr, or NULL if the memory could not be allocated
+ */
+static uint64_t *radix64(uint64_t *arr,size_t n)
+{
+	struct radix64_work *w;
+	uint64_t *tmp,*src=arr,*dst,*swap;
+	size_t i,b;
+	int pass;
+	if(n<2){
+		return arr;
+	}
+	if(alloc_lines((void**)&tmp,n*sizeof(uint64_t))!=0){
+		return NULL;
+	}
+	if(alloc_lines((void**)&w,sizeof(struct radix64_work))!=0){
+		free(tmp);
+		return NULL;
+	}
+	memset(w->hist,0,sizeof(w->hist));
+	dst=tmp;
+	for(i=0;i<n;i++){
+		uint64_t x=arr[i];
+		for(pass=0;pass<PASSES64;pass++){
+			w->hist[pass][(x>>(pass*BITS64))&(BUCKETS64-1)]++;
+		}
+	}
+	for(pass=0;pass<PASSES64;pass++){
+		unsigned int shift=pass*BITS64;
+		size_t *offset=w->hist[pass];
+		if(offset[(src[0]>>shift)&(BUCKETS64-1)]==n){
+			continue;
+		}
+		prefix_sums(offset,BUCKETS64);
+		memcpy(w->start,offset,sizeof(w->start));
+		for(i=0;i<n;i++){
+			uint64_t x=src[i];
+			size_t o;
+			b=(x>>shift)&(BUCKETS64-1);
+			o=offset[b]++;
+			w->wc[b][o&(WC64-1)]=x;
+			if(((o+1)&(WC64-1))==0){
+				flush(dst,w->wc[b],w->start[b],o+1,sizeof(uint64_t),WC64);
+			}
+		}
+		for(b=0;b<BUCKETS64;b++){
+			if(offset[b]&(WC64-1)){
+				flush(dst,w->wc[b],w->start[b],offset[b],sizeof(uint64_t),WC64);
+			}
+		}
+		swap=src;
+		src=dst;
+		dst=swap;
+	}
+	if(src!=arr){
+		memcpy(arr,src,n*sizeof(uint64_t));
+	}
+	free(w);
+	free(tmp);
+	return arr;
+}
+
+/** @brief Internal functions mapping keys to unsigned keys of the same order, and back */
+static void flip_sign32(uint32_t *arr,size_t n)
+{
+	size_t i;
+	for(i=0;i<n;i++){
+		arr[i]^=UINT32_C(1)<<31;
+	}
+}
+
+static void flip_sign64(uint64_t *arr,size_t n)
+{
+	size_t i;
+	for(i=0;i<n;i++){
+		arr[i]^=UINT64_C(1)<<63;
+	}
+}
+
+/* Negative numbers are ordered backwards, all their bits are flipped */
+static void float_to_key32(uint32_t *arr,size_t n)
+{
+	size_t i;
+	for(i=0;i<n;i++){
+		arr[i]^=(uint32_t)-(int32_t)(arr[i]>>31)|UINT32_C(1)<<31;
+	}
+}
+
+static void key_to_float32(uint32_t *arr,size_t n)
+{
+	size_t i;
+	for(i=0;i<n;i++){
+		arr[i]^=(uint32_t)-(int32_t)((arr[i]>>31)^1)|UINT32_C(1)<<31;
+	}
+}
+
+static void float_to_key64(uint64_t *arr,size_t n)
+{
+	size_t i;
+	for(i=0;i<n;i++){
+		arr[i]^=(uint64_t)-(int64_t)(arr[i]>>63)|UINT64_C(1)<<63;
+	}
+}
+
+static void key_to_float64(uint64_t *arr,size_t n)
+{
+	size_t i;
+	for(i=0;i<n;i++){
+		arr[i]^=(uint64_t)-(int64_t)((arr[i]>>63)^1)|UINT64_C(1)<<63;
+	}
+}
+
+uint32_t *gRadixSortU32(uint32_t *arr,size_t n)
+{
+	return radix32(arr,n);
+}
+
+int32_t *gRadixSortI32(int32_t *arr,size_t n)
+{
+	uint32_t *keys=(uint32_t*)arr;
+	flip_sign32(keys,n);
+	keys=radix32(keys,n);
+	flip_sign32((uint32_t*)arr,n);
+	return keys==NULL?NULL:arr;
+}
+
+uint64_t *gRadixSortU64(uint64_t *arr,size_t n)
+{
+	return radix64(arr,n);
+}
+
+int64_t *gRadixSortI64(int64_t *arr,size_t n)
+{
+	uint64_t *keys=(uint64_t*)arr;
+	flip_sign64(keys,n);
+	keys=radix64(keys,n);
+	flip_sign64((uint64_t*)arr,n);
+	return keys==NULL?NULL:arr;
+}
+
+float *gRadixSortFloat(float *arr,size_t n)
+{
+	uint32_t *keys=(uint32_t*)arr;
+	float_to_key32(keys,n);
+	keys=radix32(keys,n);
+	key_to_float32((uint32_t*)arr,n);
+	return keys==NULL?NULL:arr;
+}
+
+double *gRadixSortDouble(double *arr,size_t n)
+{
+	uint64_t *keys=(uint64_t*)arr;
+	float_to_key64(keys,n);
+	keys=radix64(keys,n);
+	key_to_float64((uint64_t*)arr,n);
+	return keys==NULL?NULL:arr;
+}
+
+/** @brief Internal function reading a record key as an unsigned key of the same order */
+static uint64_t record_key(const char *rec,size_t key_width,int flags)
+{
+	uint8_t k8;
+	uint16_t k16;
+	uint32_t k32;
+	uint64_t k=0;
+	switch(key_width){
+	case 1:
+		memcpy(&k8,rec,1);
+		k=k8;
+		break;
+	case 2:
+		memcpy(&k16,rec,2);
+		k=k16;
+		break;
+	case 4:
+		memcpy(&k32,rec,4);
+		k=k32;
+		break;
+	case 8:
+		memcpy(&k,rec,8);
+		break;
+	}
+	if(flags&G_RADIX_SIGNED){
+		k^=UINT64_C(1)<<(8*key_width-1);
+	}
+	return k;
+}
+
+void *gRadixSortRecords(void *base,size_t n,size_t elem_sz,size_t key_offset,size_t key_width,int flags)
+{
+	char *src=(char*)base,*dst,*tmp,*swap;
+	size_t (*hist)[BUCKETS64];
+	size_t i,pass;
+	if((key_width!=1&&key_width!=2&&key_width!=4&&key_width!=8)||key_offset+key_width>elem_sz){
+		gErrorCode=G_EINVAL;
+		return NULL;
+	}
+	if(n<2){
+		return base;
+	}
+	tmp=malloc(n*elem_sz);
+	hist=calloc(key_width,sizeof(*hist));
+	if(tmp==NULL||hist==NULL){
+		free(tmp);
+		free(hist);
+		gErrorCode=G_ENOMEN;
+		return NULL;
+	}
+	dst=tmp;
+	for(i=0;i<n;i++){
+		uint64_t k=record_key(src+i*elem_sz+key_offset,key_width,flags);
+		for(pass=0;pass<key_width;pass++){
+			hist[pass][(k>>(pass*BITS64))&(BUCKETS64-1)]++;
+		}
+	}
+	for(pass=0;pass<key_width;pass++){
+		unsigned int shift=(unsigned int)pass*BITS64;
+		size_t *offset=hist[pass];
+		if(offset[(record_key(src+key_offset,key_width,flags)>>shift)&(BUCKETS64-1)]==n){
+			continue;
+		}
+		prefix_sums(offset,BUCKETS64);
+		for(i=0;i<n;i++){
+			size_t b=(record_key(src+i*elem_sz+key_offset,key_width,flags)>>shift)&(BUCKETS64-1);
+			memcpy(dst+offset[b]*elem_sz,src+i*elem_sz,elem_sz);
+			offset[b]++;
+		}
+		swap=src;
+		src=dst;
+		dst=swap;
+	}
+	if(src!=(char*)base){
+		memcpy(base,src,n*elem_sz);
+	}
+	free(hist);
+	free(tmp);
+	return base;
+}
+/** @} */
@@ -0,0 +1,270 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/algorithm/select.h>
+#include <generic/utils.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+/** @addtogroup select
+ * @{
+ */
+
+/** @brief Ranges this short are finished by insertion sort */
+#define	SELECT_INSERTION	16
+/** @brief Ranges this long take a ninther as the pivot */
+#define	SELECT_NINTHER	128
+
+#define	AT(i)	(a+(i)*sz)
+#define	LESS(x,y)	(cmp((void*)(x),(void*)(y))<0)
+
+/** @brief Internal function sorting [lo,hi) by insertion */
+static void insertion_sort(char *a,size_t lo,size_t hi,size_t sz,cmpfunc_t cmp)
+{
+	size_t i,j;
+	for(i=lo+1;i<hi;i++){
+		for(j=i;j>lo&&LESS(AT(j),AT(j-1));j--){
+			gSwap(AT(j),AT(j-1),sz);
+		}
+	}
+}
+
+/** @brief Internal function returning the index of the median of three */
+static size_t median3(char *a,size_t x,size_t y,size_t z,size_t sz,cmpfunc_t cmp)
+{
+	if(LESS(AT(y),AT(x))){
+		size_t t=x;
+		x=y;
+		y=t;
+	}
+	if(LESS(AT(z),AT(y))){
+		y=LESS(AT(z),AT(x))?x:z;
+	}
+	return y;
+}
+
+/** @brief Internal function restoring a heap below node i
+ *
+ * The heap is [base,base+n), with the element that must not be above
+ * the others first: the largest for a max-heap, with max set, the
+ * smallest otherwise.
+ */
+static void sift_down(char *base,size_t n,size_t i,size_t sz,cmpfunc_t cmp,int max)
+{
+	char *a=base;
+	for(;;){
+		size_t child=2*i+1;
+		if(child>=n){
+			break;
+		}
+		if(child+1<n&&(max?LESS(AT(child),AT(child+1)):LESS(AT(child+1),AT(child)))){
+			child++;
+		}
+		if(max?!LESS(AT(i),AT(child)):!LESS(AT(child),AT(i))){
+			break;
+		}
+		gSwap(AT(i),AT(child),sz);
+		i=child;
+	}
+}
+
+/** @brief Internal function selecting by heap, the fallback of introselect
+ *
+ * Keeps the nth-lo+1 smallest elements of [lo,hi) in a max-heap at the
+ * front, then moves its top to nth.
+ */
+static void heap_select(char *a,size_t lo,size_t hi,size_t nth,size_t sz,cmpfunc_t cmp)
+{
+	char *h=AT(lo);
+	size_t k=nth-lo+1,i;
+	for(i=k/2;i>0;i--){
+		sift_down(h,k,i-1,sz,cmp,1);
+	}
+	for(i=lo+k;i<hi;i++){
+		if(LESS(AT(i),h)){
+			gSwap(AT(i),h,sz);
+			sift_down(h,k,0,sz,cmp,1);
+		}
+	}
+	gSwap(h,AT(nth),sz);
+}
+
+/** @brief Internal function partitioning [lo,hi) around the element at lo
+ *
+ * Equal elements stop both scans, so ranges of duplicates split evenly.
+ *
+ * @return	Final index of the pivot
+ */
+static size_t partition(char *a,size_t lo,size_t hi,size_t sz,cmpfunc_t cmp)
+{
+	const char *p=AT(lo);
+	size_t i=lo+1,j=hi-1;
+	for(;;){
+		while(i<=j&&LESS(AT(i),p)){
+			i++;
+		}
+		// The pivot stops this scan at lo
+		while(LESS(p,AT(j))){
+			j--;
+		}
+		if(i>=j){
+			break;
+		}
+		gSwap(AT(i),AT(j),sz);
+		i++;
+		j--;
+	}
+	gSwap(AT(lo),AT(j),sz);
+	return j;
+}
+
+void *gNthElement(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,size_t nth)
+{
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	char *a=(char*)arr;
+	size_t sz=elem_sz,lo=0,hi=n,len;
+	cmpfunc_t cmp=cmpfunc;
+	int budget=0;
+	if(nth>=n){
+		return arr;
+	}
+	// Twice the depth of a balanced quickselect
+	for(len=n;len>1;len>>=1){
+		budget+=2;
+	}
+	while(hi-lo>SELECT_INSERTION){
+		size_t mid=lo+(hi-lo)/2,pivot;
+		if(budget--==0){
+			heap_select(a,lo,hi,nth,sz,cmp);
+			return arr;
+		}
+		if(hi-lo>=SELECT_NINTHER){
+			size_t s=(hi-lo)/8;
+			pivot=median3(a,median3(a,lo,lo+s,lo+2*s,sz,cmp),
+			              median3(a,mid-s,mid,mid+s,sz,cmp),
+			              median3(a,hi-1-2*s,hi-1-s,hi-1,sz,cmp),sz,cmp);
+		}else{
+			pivot=median3(a,lo,mid,hi-1,sz,cmp);
+		}
+		gSwap(AT(lo),AT(pivot),sz);
+		pivot=partition(a,lo,hi,sz,cmp);
+		if(pivot==nth){
+			return arr;
+		}
+		if(nth<pivot){
+			hi=pivot;
+		}else{
+			lo=pivot+1;
+		}
+	}
+	insertion_sort(a,lo,hi,sz,cmp);
+	return arr;
+}
+
+void *gPartialSort(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc,size_t k)
+{
+	if(k>=n){
+		return gSort(arr,n,elem_sz,cmpfunc);
+	}
+	if(k==0){
+		return arr;
+	}
+	gNthElement(arr,n,elem_sz,cmpfunc,k-1);
+	if(gSort(arr,k-1,elem_sz,cmpfunc)==NULL){
+		return NULL;
+	}
+	return arr;
+}
+
+gTopK *gTopKCreate(size_t elem_sz,size_t k,cmpfunc_t cmpfunc)
+{
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	gTopK *top;
+	if(k==0){
+		gErrorCode=G_EINVAL;
+		return NULL;
+	}
+	top=malloc(sizeof(gTopK));
+	if(top==NULL){
+		gErrorCode=G_ENOMEN;
+		return NULL;
+	}
+	top->heap=malloc(k*elem_sz);
+	if(top->heap==NULL){
+		free(top);
+		gErrorCode=G_ENOMEN;
+		return NULL;
+	}
+	top->n=0;
+	top->k=k;
+	top->elem_sz=elem_sz;
+	top->cmpfunc=cmpfunc;
+	return top;
+}
+
+void gTopKDelete(gTopK *top)
+{
+	if(top!=NULL){
+		free(top->heap);
+		free(top);
+	}
+}
+
+void gTopKAddBatch(gTopK *top,const void *elems,size_t n)
+{
+	assert(top!=NULL);
+	const char *x=(const char*)elems,*end=x+n*top->elem_sz;
+	char *a=top->heap;
+	size_t sz=top->elem_sz;
+	cmpfunc_t cmp=top->cmpfunc;
+	// Fill the heap, then build it once
+	for(;x<end&&top->n<top->k;x+=sz){
+		memcpy(AT(top->n),x,sz);
+		if(++top->n==top->k){
+			size_t i;
+			for(i=top->k/2;i>0;i--){
+				sift_down(a,top->k,i-1,sz,cmp,0);
+			}
+		}
+	}
+	// Most elements are rejected by one comparison with the smallest kept
+	for(;x<end;x+=sz){
+		if(LESS(a,x)){
+			memcpy(a,x,sz);
+			sift_down(a,top->k,0,sz,cmp,0);
+		}
+	}
+}
+
+size_t gTopKResult(gTopK *top,void *out)
+{
+	assert(top!=NULL);
+	memcpy(out,top->heap,top->n*top->elem_sz);
+	gSort(out,top->n,top->elem_sz,top->cmpfunc);
+	gReverse(out,top->n,top->elem_sz);
+	return top->n;
+}
+/** @} */
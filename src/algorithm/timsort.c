@@ -0,0 +1,568 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/algorithm/timsort.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+/** @addtogroup timsort
+ * @{
+ */
+
+/** @brief Arrays shorter than this are sorted by binary insertion only */
+#define	MIN_MERGE	32
+/** @brief Initial number of wins in a row before galloping */
+#define	MIN_GALLOP	7
+/** @brief Pending runs, enough for 2^64 elements with the invariants kept */
+#define	MAX_PENDING	85
+
+/** @brief State of a sort */
+struct tim_ctx{
+	char *a;
+	size_t sz;
+	cmpfunc_t cmp;
+	/** @brief Room for n/2 elements, holds the smaller run of a merge */
+	char *tmp;
+	/** @brief Room for one element */
+	char *pivot;
+	ptrdiff_t min_gallop;
+	ptrdiff_t run_base[MAX_PENDING];
+	ptrdiff_t run_len[MAX_PENDING];
+	int pending;
+};
+
+/*
+ * The macros use copies of the context fields in locals: read through the
+ * context, they would be reloaded after every memcpy, which may alias it.
+ */
+#define	LESS(x,y)	(cmp((void*)(x),(void*)(y))<0)
+#define	AT(i)	(a+(i)*sz)
+#define	TMP(i)	(t+(i)*sz)
+
+/** @brief Internal function copying one element
+ *
+ * The common sizes get a fixed size memcpy, which compiles to plain
+ * loads and stores instead of a library call.
+ */
+static inline void copy_elem(char *dst,const char *src,ptrdiff_t sz)
+{
+	switch(sz){
+	case 4:
+		memcpy(dst,src,4);
+		break;
+	case 8:
+		memcpy(dst,src,8);
+		break;
+	case 16:
+		memcpy(dst,src,16);
+		break;
+	default:
+		memcpy(dst,src,sz);
+	}
+}
+
+/** @brief Internal function computing the minimum run length
+ *
+ * The top 6 bits of n, plus one if any other bit is set, so that n over
+ * it is a power of two or slightly less.
+ */
+static ptrdiff_t min_run_length(size_t n)
+{
+	size_t r=0;
+	while(n>=MIN_MERGE*2){
+		r|=n&1;
+		n>>=1;
+	}
+	return (ptrdiff_t)(n+r);
+}
+
+/** @brief Internal function reversing [lo,hi) */
+static void reverse_range(struct tim_ctx *c,ptrdiff_t lo,ptrdiff_t hi)
+{
+	char *a=c->a,*pivot=c->pivot;
+	const ptrdiff_t sz=(ptrdiff_t)c->sz;
+	for(hi--;lo<hi;lo++,hi--){
+		memcpy(pivot,AT(lo),sz);
+		memcpy(AT(lo),AT(hi),sz);
+		memcpy(AT(hi),pivot,sz);
+	}
+}
+
+/** @brief Internal function finding the run starting at lo
+ *
+ * A strictly descending run is reversed, equal elements must not be
+ * swapped for the sort to stay stable.
+ *
+ * @return	Length of the run
+ */
+static ptrdiff_t count_run(struct tim_ctx *c,ptrdiff_t lo,ptrdiff_t hi)
+{
+	char *a=c->a;
+	const ptrdiff_t sz=(ptrdiff_t)c->sz;
+	const cmpfunc_t cmp=c->cmp;
+	ptrdiff_t run_hi=lo+1;
+	if(run_hi==hi){
+		return 1;
+	}
+	if(LESS(AT(run_hi),AT(lo))){
+		run_hi++;
+		while(run_hi<hi&&LESS(AT(run_hi),AT(run_hi-1))){
+			run_hi++;
+		}
+		reverse_range(c,lo,run_hi);
+	}else{
+		run_hi++;
+		while(run_hi<hi&&!LESS(AT(run_hi),AT(run_hi-1))){
+			run_hi++;
+		}
+	}
+	return run_hi-lo;
+}
+
+/** @brief Internal function sorting [lo,hi) by binary insertion, [lo,start) being sorted */
+static void binary_sort(struct tim_ctx *c,ptrdiff_t lo,ptrdiff_t hi,ptrdiff_t start)
+{
+	char *a=c->a,*pivot=c->pivot;
+	const ptrdiff_t sz=(ptrdiff_t)c->sz;
+	const cmpfunc_t cmp=c->cmp;
+	if(start==lo){
+		start++;
+	}
+	for(;start<hi;start++){
+		ptrdiff_t left=lo,right=start;
+		copy_elem(pivot,AT(start),sz);
+		// Insert after the elements equal to the pivot
+		while(left<right){
+			ptrdiff_t mid=left+(right-left)/2;
+			if(LESS(pivot,AT(mid))){
+				right=mid;
+			}else{
+				left=mid+1;
+			}
+		}
+		memmove(AT(left+1),AT(left),(start-left)*sz);
+		copy_elem(AT(left),pivot,sz);
+	}
+}
+
+/** @brief Internal function finding where key goes in a sorted range,
+ * before the elements equal to it
+ *
+ * Searches from hint by steps of 1, 3, 7, 15... then by bisection.
+ *
+ * @param key:	The element looked for
+ * @param base:	Start of the sorted range
+ * @param len:	Length of the range
+ * @param hint:	Index to start at
+ *
+ * @return	k such that base[k-1] < key <= base[k]
+ */
+static ptrdiff_t gallop_left(struct tim_ctx *c,const char *key,const char *base,ptrdiff_t len,ptrdiff_t hint)
+{
+	const cmpfunc_t cmp=c->cmp;
+	ptrdiff_t last_ofs=0,ofs=1,max_ofs,tmp;
+	const ptrdiff_t sz=(ptrdiff_t)c->sz;
+	if(LESS(base+hint*sz,key)){
+		max_ofs=len-hint;
+		while(ofs<max_ofs&&LESS(base+(hint+ofs)*sz,key)){
+			last_ofs=ofs;
+			ofs=(ofs<<1)+1;
+		}
+		if(ofs>max_ofs){
+			ofs=max_ofs;
+		}
+		last_ofs+=hint;
+		ofs+=hint;
+	}else{
+		max_ofs=hint+1;
+		while(ofs<max_ofs&&!LESS(base+(hint-ofs)*sz,key)){
+			last_ofs=ofs;
+			ofs=(ofs<<1)+1;
+		}
+		if(ofs>max_ofs){
+			ofs=max_ofs;
+		}
+		tmp=last_ofs;
+		last_ofs=hint-ofs;
+		ofs=hint-tmp;
+	}
+	// base[last_ofs] < key <= base[ofs]
+	last_ofs++;
+	while(last_ofs<ofs){
+		ptrdiff_t m=last_ofs+(ofs-last_ofs)/2;
+		if(LESS(base+m*sz,key)){
+			last_ofs=m+1;
+		}else{
+			ofs=m;
+		}
+	}
+	return ofs;
+}
+
+/** @brief Internal function finding where key goes in a sorted range,
+ * after the elements equal to it
+ *
+ * @return	k such that base[k-1] <= key < base[k]
+ *
+ * @see gallop_left
+ */
+static ptrdiff_t gallop_right(struct tim_ctx *c,const char *key,const char *base,ptrdiff_t len,ptrdiff_t hint)
+{
+	const cmpfunc_t cmp=c->cmp;
+	ptrdiff_t last_ofs=0,ofs=1,max_ofs,tmp;
+	const ptrdiff_t sz=(ptrdiff_t)c->sz;
+	if(LESS(key,base+hint*sz)){
+		max_ofs=hint+1;
+		while(ofs<max_ofs&&LESS(key,base+(hint-ofs)*sz)){
+			last_ofs=ofs;
+			ofs=(ofs<<1)+1;
+		}
+		if(ofs>max_ofs){
+			ofs=max_ofs;
+		}
+		tmp=last_ofs;
+		last_ofs=hint-ofs;
+		ofs=hint-tmp;
+	}else{
+		max_ofs=len-hint;
+		while(ofs<max_ofs&&!LESS(key,base+(hint+ofs)*sz)){
+			last_ofs=ofs;
+			ofs=(ofs<<1)+1;
+		}
+		if(ofs>max_ofs){
+			ofs=max_ofs;
+		}
+		last_ofs+=hint;
+		ofs+=hint;
+	}
+	// base[last_ofs] <= key < base[ofs]
+	last_ofs++;
+	while(last_ofs<ofs){
+		ptrdiff_t m=last_ofs+(ofs-last_ofs)/2;
+		if(LESS(key,base+m*sz)){
+			ofs=m;
+		}else{
+			last_ofs=m+1;
+		}
+	}
+	return ofs;
+}
+
+/** @brief Internal function merging two adjacent runs, the first one
+ * being the shorter
+ *
+ * The first run is moved to tmp and merged from the left. The first
+ * element of run 2 is known to go before all of run 1, and the last of
+ * run 1 after all of run 2.
+ */
+static void merge_lo(struct tim_ctx *c,ptrdiff_t base1,ptrdiff_t len1,ptrdiff_t base2,ptrdiff_t len2)
+{
+	char *a=c->a,*t=c->tmp;
+	const ptrdiff_t sz=(ptrdiff_t)c->sz;
+	const cmpfunc_t cmp=c->cmp;
+	ptrdiff_t cursor1=0,cursor2=base2,dest=base1;
+	ptrdiff_t min_gallop=c->min_gallop;
+	memcpy(t,AT(base1),len1*sz);
+	copy_elem(AT(dest++),AT(cursor2++),sz);
+	if(--len2==0){
+		memcpy(AT(dest),TMP(cursor1),len1*sz);
+		return;
+	}
+	if(len1==1){
+		memmove(AT(dest),AT(cursor2),len2*sz);
+		memcpy(AT(dest+len2),TMP(cursor1),sz);
+		return;
+	}
+	for(;;){
+		ptrdiff_t count1=0,count2=0;
+		// One element at a time until a run wins min_gallop times in a row
+		do{
+			if(LESS(AT(cursor2),TMP(cursor1))){
+				copy_elem(AT(dest++),AT(cursor2++),sz);
+				count2++;
+				count1=0;
+				if(--len2==0){
+					goto done;
+				}
+			}else{
+				copy_elem(AT(dest++),TMP(cursor1++),sz);
+				count1++;
+				count2=0;
+				if(--len1==1){
+					goto done;
+				}
+			}
+		}while((count1|count2)<min_gallop);
+		// Then gallop while it keeps paying off
+		do{
+			count1=gallop_right(c,AT(cursor2),TMP(cursor1),len1,0);
+			if(count1!=0){
+				memcpy(AT(dest),TMP(cursor1),count1*sz);
+				dest+=count1;
+				cursor1+=count1;
+				len1-=count1;
+				if(len1<=1){
+					goto done;
+				}
+			}
+			copy_elem(AT(dest++),AT(cursor2++),sz);
+			if(--len2==0){
+				goto done;
+			}
+			count2=gallop_left(c,TMP(cursor1),AT(cursor2),len2,0);
+			if(count2!=0){
+				memmove(AT(dest),AT(cursor2),count2*sz);
+				dest+=count2;
+				cursor2+=count2;
+				len2-=count2;
+				if(len2==0){
+					goto done;
+				}
+			}
+			copy_elem(AT(dest++),TMP(cursor1++),sz);
+			if(--len1==1){
+				goto done;
+			}
+			min_gallop--;
+		}while(count1>=MIN_GALLOP||count2>=MIN_GALLOP);
+		if(min_gallop<0){
+			min_gallop=0;
+		}
+		// Penalize leaving gallop mode
+		min_gallop+=2;
+	}
+done:
+	c->min_gallop=min_gallop<1?1:min_gallop;
+	if(len1==1){
+		memmove(AT(dest),AT(cursor2),len2*sz);
+		memcpy(AT(dest+len2),TMP(cursor1),sz);
+	}else if(len1>0){
+		memcpy(AT(dest),TMP(cursor1),len1*sz);
+	}
+}
+
+/** @brief Internal function merging two adjacent runs, the second one
+ * being the shorter
+ *
+ * Mirror of merge_lo: the second run is moved to tmp and the merge goes
+ * from the right.
+ */
+static void merge_hi(struct tim_ctx *c,ptrdiff_t base1,ptrdiff_t len1,ptrdiff_t base2,ptrdiff_t len2)
+{
+	char *a=c->a,*t=c->tmp;
+	const ptrdiff_t sz=(ptrdiff_t)c->sz;
+	const cmpfunc_t cmp=c->cmp;
+	ptrdiff_t cursor1=base1+len1-1,cursor2=len2-1,dest=base2+len2-1;
+	ptrdiff_t min_gallop=c->min_gallop;
+	memcpy(t,AT(base2),len2*sz);
+	copy_elem(AT(dest--),AT(cursor1--),sz);
+	if(--len1==0){
+		memcpy(AT(dest-(len2-1)),t,len2*sz);
+		return;
+	}
+	if(len2==1){
+		dest-=len1;
+		cursor1-=len1;
+		memmove(AT(dest+1),AT(cursor1+1),len1*sz);
+		memcpy(AT(dest),TMP(cursor2),sz);
+		return;
+	}
+	for(;;){
+		ptrdiff_t count1=0,count2=0;
+		do{
+			if(LESS(TMP(cursor2),AT(cursor1))){
+				copy_elem(AT(dest--),AT(cursor1--),sz);
+				count1++;
+				count2=0;
+				if(--len1==0){
+					goto done;
+				}
+			}else{
+				copy_elem(AT(dest--),TMP(cursor2--),sz);
+				count2++;
+				count1=0;
+				if(--len2==1){
+					goto done;
+				}
+			}
+		}while((count1|count2)<min_gallop);
+		do{
+			count1=len1-gallop_right(c,TMP(cursor2),AT(base1),len1,len1-1);
+			if(count1!=0){
+				dest-=count1;
+				cursor1-=count1;
+				len1-=count1;
+				memmove(AT(dest+1),AT(cursor1+1),count1*sz);
+				if(len1==0){
+					goto done;
+				}
+			}
+			copy_elem(AT(dest--),TMP(cursor2--),sz);
+			if(--len2==1){
+				goto done;
+			}
+			count2=len2-gallop_left(c,AT(cursor1),t,len2,len2-1);
+			if(count2!=0){
+				dest-=count2;
+				cursor2-=count2;
+				len2-=count2;
+				memcpy(AT(dest+1),TMP(cursor2+1),count2*sz);
+				if(len2<=1){
+					goto done;
+				}
+			}
+			copy_elem(AT(dest--),AT(cursor1--),sz);
+			if(--len1==0){
+				goto done;
+			}
+			min_gallop--;
+		}while(count1>=MIN_GALLOP||count2>=MIN_GALLOP);
+		if(min_gallop<0){
+			min_gallop=0;
+		}
+		min_gallop+=2;
+	}
+done:
+	c->min_gallop=min_gallop<1?1:min_gallop;
+	if(len2==1){
+		dest-=len1;
+		cursor1-=len1;
+		memmove(AT(dest+1),AT(cursor1+1),len1*sz);
+		memcpy(AT(dest),TMP(cursor2),sz);
+	}else if(len2>0){
+		memcpy(AT(dest-(len2-1)),t,len2*sz);
+	}
+}
+
+/** @brief Internal function merging the runs i and i+1 of the stack */
+static void merge_at(struct tim_ctx *c,int i)
+{
+	char *a=c->a;
+	const ptrdiff_t sz=(ptrdiff_t)c->sz;
+	ptrdiff_t base1=c->run_base[i],len1=c->run_len[i];
+	ptrdiff_t base2=c->run_base[i+1],len2=c->run_len[i+1];
+	ptrdiff_t k;
+	c->run_len[i]=len1+len2;
+	if(i==c->pending-3){
+		c->run_base[i+1]=c->run_base[i+2];
+		c->run_len[i+1]=c->run_len[i+2];
+	}
+	c->pending--;
+	// Elements of run 1 before the first of run 2 are already in place
+	k=gallop_right(c,AT(base2),AT(base1),len1,0);
+	base1+=k;
+	len1-=k;
+	if(len1==0){
+		return;
+	}
+	// and so are the elements of run 2 after the last of run 1
+	len2=gallop_left(c,AT(base1+len1-1),AT(base2),len2,len2-1);
+	if(len2==0){
+		return;
+	}
+	if(len1<=len2){
+		merge_lo(c,base1,len1,base2,len2);
+	}else{
+		merge_hi(c,base1,len1,base2,len2);
+	}
+}
+
+/** @brief Internal function merging runs until the invariants hold again
+ *
+ * For the runs ..., W, X, Y, Z on top of the stack:
+ * X > Y + Z, W > X + Y and Y > Z. Checking W as well is the correction.
+ */
+static void merge_collapse(struct tim_ctx *c)
+{
+	while(c->pending>1){
+		int k=c->pending-2;
+		ptrdiff_t *len=c->run_len;
+		if((k>0&&len[k-1]<=len[k]+len[k+1])||(k>1&&len[k-2]<=len[k-1]+len[k])){
+			if(len[k-1]<len[k+1]){
+				k--;
+			}
+		}else if(len[k]>len[k+1]){
+			break;
+		}
+		merge_at(c,k);
+	}
+}
+
+/** @brief Internal function merging all the runs left */
+static void merge_force_collapse(struct tim_ctx *c)
+{
+	while(c->pending>1){
+		int k=c->pending-2;
+		if(k>0&&c->run_len[k-1]<c->run_len[k+1]){
+			k--;
+		}
+		merge_at(c,k);
+	}
+}
+
+void *gTimSort(void *arr,size_t n,size_t elem_sz,cmpfunc_t cmpfunc)
+{
+	assert(cmpfunc!=NULL);
+	assert(elem_sz>0);
+	struct tim_ctx c;
+	ptrdiff_t lo=0,remaining=(ptrdiff_t)n,min_run,run_len;
+	if(n<2){
+		return arr;
+	}
+	c.a=(char*)arr;
+	c.sz=elem_sz;
+	c.cmp=cmpfunc;
+	c.min_gallop=MIN_GALLOP;
+	c.pending=0;
+	c.tmp=malloc((n/2+1)*elem_sz);
+	if(c.tmp==NULL){
+		gErrorCode=G_ENOMEN;
+		return NULL;
+	}
+	c.pivot=c.tmp+(n/2)*elem_sz;
+	if(n<MIN_MERGE){
+		binary_sort(&c,0,(ptrdiff_t)n,count_run(&c,0,(ptrdiff_t)n));
+		free(c.tmp);
+		return arr;
+	}
+	min_run=min_run_length(n);
+	do{
+		run_len=count_run(&c,lo,lo+remaining);
+		if(run_len<min_run){
+			ptrdiff_t force=remaining<min_run?remaining:min_run;
+			binary_sort(&c,lo,lo+force,lo+run_len);
+			run_len=force;
+		}
+		c.run_base[c.pending]=lo;
+		c.run_len[c.pending]=run_len;
+		c.pending++;
+		merge_collapse(&c);
+		lo+=run_len;
+		remaining-=run_len;
+	}while(remaining!=0);
+	merge_force_collapse(&c);
+	free(c.tmp);
+	return arr;
+}
+/** @} */
@@ -23,6 +23,7 @@
  */
 
 #include <generic/avl.h>
+#include <generic/bloom.h>
 #include <string.h>
 
 /**
@@ -141,6 +142,16 @@ static void rightRotate(gAVL *avl_tree, avl_node_t *x);
 
 static void rebalance(gAVL* avl_tree, avl_node_t* node);
 
+/**
+ * Function: fillFilter
+ * --------------------
+ * Add every item of a subtree to a filter.
+ *
+ * @param filter    The filter
+ * @param node      Root of the subtree
+ */
+static void fillFilter(gBloom *filter, avl_node_t *node);
+
 /*  ------------------------------- *
  *
  *  The API implementations follow.
@@ -156,6 +167,7 @@ gAVL* gAVLCreate(size_t elementSize, gDataCompare comparator) {
     avl_tree->root = NULL;
     avl_tree->elementSize = elementSize;
     avl_tree->isGreater = comparator;
+    avl_tree->filter = NULL;
     return avl_tree;
 }
 
@@ -170,10 +182,14 @@ int gAVLAdd(gAVL *avl_tree, void *item){
         if (avl_tree->root == NULL){
             return gErrorCode;
         }
-        return 0;
     }
-    avl_tree->root = addNode(avl_tree->root, node, avl_tree->isGreater);
-    rebalance(avl_tree , node);
+    else {
+        avl_tree->root = addNode(avl_tree->root, node, avl_tree->isGreater);
+        rebalance(avl_tree , node);
+    }
+    if (avl_tree->filter != NULL) {
+        gBloomAdd(avl_tree->filter, item);
+    }
     return 0;
 }
 
@@ -192,11 +208,30 @@ avl_node_t *gAVLSearch(gAVL *avl_tree, void *data) {
         gErrorCode = G_ENOITM;
         return NULL;
     }
+    if (avl_tree->filter != NULL && !gBloomContains(avl_tree->filter, data)) {
+        return NULL;
+    }
 
     return searchgAVL(avl_tree, avl_tree->root, data);    // Nothing found, return a null pointer
 
 }
 
+int gAVLAttachFilter(gAVL *avl_tree, gBloom *filter) {
+    if (avl_tree == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    if (filter != NULL && filter->keySize != avl_tree->elementSize) {
+        gErrorCode = G_EINVAL;
+        return gErrorCode;
+    }
+    if (filter != NULL && avl_tree->root != NULL) {
+        fillFilter(filter, avl_tree->root);
+    }
+    avl_tree->filter = filter;
+    return 0;
+}
+
 /*  --------------------------------- *
  *
  *  Utility function implementations.
@@ -266,6 +301,14 @@ static avl_node_t* searchgAVL(gAVL *avl_tree, avl_node_t *current_root, void *da
     }
 }
 
+static void fillFilter(gBloom *filter, avl_node_t *node){
+    gBloomAdd(filter, node->data);
+    if(node->left != NULL)
+        fillFilter(filter, node->left);
+    if(node->right != NULL)
+        fillFilter(filter, node->right);
+}
+
 static int max(int x, int y)
 {
     return x > y? x: y;
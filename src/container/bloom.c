@@ -0,0 +1,291 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/bloom.h>
+#include "internal.h"
+#include <generic/hash.h>
+#include <math.h>
+#include <string.h>
+
+#define BLOCK_BITS      (BLOOM_BLOCK_WORDS * 64)
+#define BLOCK_SHIFT     9
+/* Odd multiplier, the top bits of the successive products select the bits of a key */
+#define BIT_MULTIPLIER  0x9e3779b1u
+#define MAX_HASHES      16
+/* Keys hashed together by the batch functions */
+#define BATCH_SIZE      64
+
+#define SERIAL_MAGIC    "GBLM"
+#define SERIAL_VERSION  1
+#define SERIAL_HEADER   40
+
+#if defined(__GNUC__)
+#define PREFETCH(addr, rw)  __builtin_prefetch(addr, rw)
+#else
+#define PREFETCH(addr, rw)
+#endif
+
+/**
+ * Function: blockOf
+ * -----------------
+ * Select the block of a key from the high half of its hash
+ *
+ * @param bloom     The filter
+ * @param hash      Hash of the key
+ *
+ * @return          First word of the block
+ */
+static uint64_t *blockOf(gBloom *bloom, uint64_t hash);
+
+/**
+ * Function: setBits
+ * -----------------
+ * Set the k bits of a key in its block. Bit positions come from the low
+ * half of the hash, the high half picked the block.
+ */
+static void setBits(gBloom *bloom, uint64_t hash);
+
+/**
+ * Function: testBits
+ * ------------------
+ * Check the k bits of a key in its block
+ *
+ * @return          (1) if all of them are set
+ */
+static int testBits(gBloom *bloom, uint64_t hash);
+
+/**
+ * Function: blockedRate
+ * ---------------------
+ * False positive rate of a blocked filter. The number of keys falling
+ * in a block follows a Poisson distribution, each block then behaves
+ * like a small classic filter.
+ *
+ * @param bitsPerKey    Size of the filter over the number of keys
+ * @param k             Number of bits set per key
+ *
+ * @return              Expected false positive rate
+ */
+static double blockedRate(double bitsPerKey, unsigned int k) {
+    double load = BLOCK_BITS / bitsPerKey;
+    double poisson = exp(-load);
+    double rate = 0;
+    int keys;
+    for (keys = 0; keys < 4 * load + 64; keys++) {
+        rate += poisson * pow(1 - pow(1 - 1.0 / BLOCK_BITS, (double) k * keys), k);
+        poisson *= load / (keys + 1);
+    }
+    return rate;
+}
+
+/*
+ * Allocate a cache line aligned, zeroed filter.
+ */
+static gBloom *allocate(size_t keySize, size_t nblocks, unsigned int k) {
+    gBloom *bloom = malloc(sizeof(gBloom));
+    if (bloom == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    void *bits;
+    if (posix_memalign(&bits, BLOOM_BLOCK_WORDS * sizeof(uint64_t), nblocks * BLOOM_BLOCK_WORDS * sizeof(uint64_t)) != 0) {
+        free(bloom);
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    memset(bits, 0, nblocks * BLOOM_BLOCK_WORDS * sizeof(uint64_t));
+    bloom->bits = (uint64_t *) bits;
+    bloom->nblocks = nblocks;
+    bloom->k = k;
+    bloom->keySize = keySize;
+    bloom->count = 0;
+    return bloom;
+}
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gBloom *gBloomCreate(size_t keySize, size_t expected, double fpRate) {
+    if (keySize == 0 || !(fpRate > 0 && fpRate < 1)) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    if (expected == 0) {
+        expected = 1;
+    }
+    // Start from the optimal size and number of hashes of a classic Bloom filter
+    double bitsPerKey = -log(fpRate) / (M_LN2 * M_LN2);
+    double k = round(bitsPerKey * M_LN2);
+    if (k < 1) k = 1;
+    if (k > MAX_HASHES) k = MAX_HASHES;
+    // then grow it until the blocks, unevenly loaded, reach the wanted rate
+    while (blockedRate(bitsPerKey, (unsigned int) k) > fpRate) {
+        bitsPerKey *= 1.02;
+    }
+    size_t nblocks = (size_t) ceil(bitsPerKey * (double) expected / BLOCK_BITS);
+    return allocate(keySize, nblocks > 0 ? nblocks : 1, (unsigned int) k);
+}
+
+void gBloomDelete(gBloom *bloom) {
+    if (bloom == NULL) {
+        return;
+    }
+    free(bloom->bits);
+    free(bloom);
+}
+
+void gBloomAdd(gBloom *bloom, void *key) {
+    setBits(bloom, gHashBytes(key, bloom->keySize));
+    bloom->count++;
+}
+
+int gBloomContains(gBloom *bloom, void *key) {
+    return testBits(bloom, gHashBytes(key, bloom->keySize));
+}
+
+void gBloomAddBatch(gBloom *bloom, void *keys, size_t n) {
+    uint64_t hashes[BATCH_SIZE];
+    char *ptr = (char *) keys;
+    size_t done, i;
+    for (done = 0; done < n; done += BATCH_SIZE) {
+        size_t count = n - done < BATCH_SIZE ? n - done : BATCH_SIZE;
+        gHashBatch(ptr + done * bloom->keySize, count, bloom->keySize, hashes);
+        for (i = 0; i < count; i++) {
+            PREFETCH(blockOf(bloom, hashes[i]), 1);
+        }
+        for (i = 0; i < count; i++) {
+            setBits(bloom, hashes[i]);
+        }
+    }
+    bloom->count += n;
+}
+
+size_t gBloomContainsBatch(gBloom *bloom, void *keys, size_t n, unsigned char *out) {
+    uint64_t hashes[BATCH_SIZE];
+    char *ptr = (char *) keys;
+    size_t found = 0;
+    size_t done, i;
+    for (done = 0; done < n; done += BATCH_SIZE) {
+        size_t count = n - done < BATCH_SIZE ? n - done : BATCH_SIZE;
+        gHashBatch(ptr + done * bloom->keySize, count, bloom->keySize, hashes);
+        for (i = 0; i < count; i++) {
+            PREFETCH(blockOf(bloom, hashes[i]), 0);
+        }
+        for (i = 0; i < count; i++) {
+            out[done + i] = (unsigned char) testBits(bloom, hashes[i]);
+            found += out[done + i];
+        }
+    }
+    return found;
+}
+
+size_t gBloomSerialize(gBloom *bloom, void *buf, size_t size) {
+    size_t words = bloom->nblocks * BLOOM_BLOCK_WORDS;
+    size_t needed = SERIAL_HEADER + words * sizeof(uint64_t);
+    if (buf == NULL || size < needed) {
+        return needed;
+    }
+    unsigned char *p = (unsigned char *) buf;
+    memcpy(p, SERIAL_MAGIC, 4);
+    putU32(p + 4, SERIAL_VERSION);
+    putU32(p + 8, bloom->k);
+    putU32(p + 12, 0);
+    putU64(p + 16, bloom->keySize);
+    putU64(p + 24, bloom->nblocks);
+    putU64(p + 32, bloom->count);
+    p += SERIAL_HEADER;
+    size_t i;
+    for (i = 0; i < words; i++) {
+        putU64(p + i * sizeof(uint64_t), bloom->bits[i]);
+    }
+    return needed;
+}
+
+gBloom *gBloomDeserialize(const void *buf, size_t size) {
+    const unsigned char *p = (const unsigned char *) buf;
+    if (buf == NULL || size < SERIAL_HEADER || memcmp(p, SERIAL_MAGIC, 4) != 0
+        || getU32(p + 4) != SERIAL_VERSION) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    unsigned int k = getU32(p + 8);
+    uint64_t keySize = getU64(p + 16);
+    uint64_t nblocks = getU64(p + 24);
+    if (k < 1 || k > MAX_HASHES || keySize == 0 || nblocks == 0
+        || nblocks > (size - SERIAL_HEADER) / (BLOOM_BLOCK_WORDS * sizeof(uint64_t))) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    gBloom *bloom = allocate((size_t) keySize, (size_t) nblocks, k);
+    if (bloom == NULL) {
+        return NULL;
+    }
+    bloom->count = (size_t) getU64(p + 32);
+    p += SERIAL_HEADER;
+    size_t i;
+    for (i = 0; i < bloom->nblocks * BLOOM_BLOCK_WORDS; i++) {
+        bloom->bits[i] = getU64(p + i * sizeof(uint64_t));
+    }
+    return bloom;
+}
+
+/*  --------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  --------------------------------- */
+
+static uint64_t *blockOf(gBloom *bloom, uint64_t hash) {
+    // Multiply-shift maps the 32 high bits onto [0, nblocks) without a division
+    size_t block = (size_t) (((hash >> 32) * (uint64_t) bloom->nblocks) >> 32);
+    return bloom->bits + block * BLOOM_BLOCK_WORDS;
+}
+
+static void setBits(gBloom *bloom, uint64_t hash) {
+    uint64_t *block = blockOf(bloom, hash);
+    uint32_t x = (uint32_t) hash;
+    unsigned int i;
+    for (i = 0; i < bloom->k; i++) {
+        x *= BIT_MULTIPLIER;
+        uint32_t bit = x >> (32 - BLOCK_SHIFT);
+        block[bit / 64] |= 1ull << (bit % 64);
+    }
+}
+
+static int testBits(gBloom *bloom, uint64_t hash) {
+    uint64_t *block = blockOf(bloom, hash);
+    uint32_t x = (uint32_t) hash;
+    unsigned int i;
+    for (i = 0; i < bloom->k; i++) {
+        x *= BIT_MULTIPLIER;
+        uint32_t bit = x >> (32 - BLOCK_SHIFT);
+        if ((block[bit / 64] & (1ull << (bit % 64))) == 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
@@ -24,6 +24,7 @@
  */
 
 #include <generic/bst.h>
+#include <generic/bloom.h>
 #include <string.h>
 
 /*
@@ -80,6 +81,16 @@ static void clearTree(bnode_t *node);
 static bnode_t* searchTree(gBST *bst, bnode_t *current_root, void *data);
 
 
+/**
+ * Function: fillFilter
+ * --------------------
+ * Add every item of a subtree to a filter.
+ *
+ * @param filter    The filter
+ * @param node      Root of the subtree
+ */
+static void fillFilter(gBloom *filter, bnode_t *node);
+
 /*  ------------------------------- *
  *
  *  The API implementations follow.
@@ -95,6 +106,7 @@ gBST* gBSTCreate(size_t elementSize, gDataCompare comparator) {
     bst->root = NULL;
     bst->elementSize = elementSize;
     bst->isGreater = comparator;
+    bst->filter = NULL;
     return bst;
 }
 
@@ -109,9 +121,13 @@ int gBSTAdd(gBST *bst, void *item) {
         if (bst->root == NULL){
             return gErrorCode;
         }
-        return 0;
     }
-    bst->root = addNode(bst->root, node, bst->isGreater);
+    else {
+        bst->root = addNode(bst->root, node, bst->isGreater);
+    }
+    if (bst->filter != NULL) {
+        gBloomAdd(bst->filter, item);
+    }
     return 0;
 }
 
@@ -130,11 +146,30 @@ bnode_t *gBSTSearch(gBST *bst, void *data) {
         gErrorCode = G_ENOITM;
         return NULL;
     }
+    if (bst->filter != NULL && !gBloomContains(bst->filter, data)) {
+        return NULL;
+    }
 
     return searchTree(bst, bst->root, data);    // Nothing found, return a null pointer
 
 }
 
+int gBSTAttachFilter(gBST *bst, gBloom *filter) {
+    if (bst == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    if (filter != NULL && filter->keySize != bst->elementSize) {
+        gErrorCode = G_EINVAL;
+        return gErrorCode;
+    }
+    if (filter != NULL && bst->root != NULL) {
+        fillFilter(filter, bst->root);
+    }
+    bst->filter = filter;
+    return 0;
+}
+
 /*  --------------------------------- *
  *
  *  Utility function implementations.
@@ -199,4 +234,12 @@ static bnode_t* searchTree(gBST *bst, bnode_t *current_root, void *data){
     else {
         return searchTree(bst, current_root->left, data);
     }
-}
\ No newline at end of file
+}
+
+static void fillFilter(gBloom *filter, bnode_t *node) {
+    gBloomAdd(filter, node->data);
+    if (node->left != NULL)
+        fillFilter(filter, node->left);
+    if (node->right != NULL)
+        fillFilter(filter, node->right);
+}
@@ -0,0 +1,266 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/cache.h>
+#include "internal.h"
+#include <string.h>
+
+/* Header of every entry, followed by its key and value */
+typedef struct cache_entry {
+    /* In order when used with LRU, in unused when not used */
+    dnode link;
+    unsigned char used;
+    unsigned char referenced;
+} cache_entry;
+
+/**
+ * Function: entryAt
+ * -----------------
+ * @param cache     The cache
+ * @param slot      Entry number
+ *
+ * @return          The entry
+ */
+static cache_entry *entryAt(gCache *cache, size_t slot);
+
+static void *keyOf(gCache *cache, cache_entry *entry);
+static void *valueOf(gCache *cache, cache_entry *entry);
+
+/**
+ * Function: touch
+ * ---------------
+ * Mark an entry as just used
+ */
+static void touch(gCache *cache, cache_entry *entry);
+
+/**
+ * Function: chooseVictim
+ * ----------------------
+ * Pick the entry to evict from a full cache
+ *
+ * @return          The entry, still in use
+ */
+static cache_entry *chooseVictim(gCache *cache);
+
+/**
+ * Function: release
+ * -----------------
+ * Drop an entry from the index and the recency list and make it unused
+ */
+static void release(gCache *cache, cache_entry *entry);
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gCache *gCacheCreate(size_t keySize, size_t valueSize, size_t capacity, int policy,
+                     gHashFunc hash, cmpfunc_t equal) {
+    if (keySize == 0 || capacity == 0 || (policy != G_CACHE_LRU && policy != G_CACHE_CLOCK)) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    gCache *cache = malloc(sizeof(gCache));
+    if (cache == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    size_t align = alignOf(keySize) > alignOf(valueSize) ? alignOf(keySize) : alignOf(valueSize);
+    if (align < sizeof(void *)) {
+        align = sizeof(void *);
+    }
+    cache->keyOffset = roundUp(sizeof(cache_entry), alignOf(keySize));
+    cache->valueOffset = roundUp(cache->keyOffset + keySize, alignOf(valueSize));
+    cache->slotSize = roundUp(cache->valueOffset + valueSize, align);
+    cache->entries = malloc(capacity * cache->slotSize);
+    cache->index = gHashMapCreate(keySize, sizeof(size_t), hash, equal);
+    if (cache->entries == NULL || cache->index == NULL || gHashMapReserve(cache->index, capacity) != 0) {
+        free(cache->entries);
+        gHashMapDelete(cache->index);
+        free(cache);
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    cache->capacity = capacity;
+    cache->size = 0;
+    cache->keySize = keySize;
+    cache->valueSize = valueSize;
+    cache->policy = policy;
+    cache->hand = 0;
+    cache->evict = NULL;
+    cache->evictContext = NULL;
+    cache->hits = 0;
+    cache->misses = 0;
+    gDListInit(&cache->order);
+    gDListInit(&cache->unused);
+    size_t slot;
+    for (slot = 0; slot < capacity; slot++) {
+        cache_entry *entry = entryAt(cache, slot);
+        entry->used = 0;
+        entry->referenced = 0;
+        gDListPushBack(&cache->unused, &entry->link);
+    }
+    return cache;
+}
+
+void gCacheDelete(gCache *cache) {
+    if (cache == NULL) {
+        return;
+    }
+    gHashMapDelete(cache->index);
+    free(cache->entries);
+    free(cache);
+}
+
+void gCacheSetEvict(gCache *cache, gCacheEvict evict, void *ctx) {
+    if (cache == NULL) {
+        gErrorCode = G_EINVLD;
+        return;
+    }
+    cache->evict = evict;
+    cache->evictContext = ctx;
+}
+
+void *gCacheGet(gCache *cache, void *key) {
+    if (cache == NULL) {
+        gErrorCode = G_EINVLD;
+        return NULL;
+    }
+    size_t *slot = gHashMapGet(cache->index, key);
+    if (slot == NULL) {
+        cache->misses++;
+        return NULL;
+    }
+    cache->hits++;
+    cache_entry *entry = entryAt(cache, *slot);
+    touch(cache, entry);
+    return valueOf(cache, entry);
+}
+
+int gCachePut(gCache *cache, void *key, void *value) {
+    if (cache == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    size_t *found = gHashMapGet(cache->index, key);
+    cache_entry *entry;
+    if (found != NULL) {
+        entry = entryAt(cache, *found);
+        memcpy(valueOf(cache, entry), value, cache->valueSize);
+        touch(cache, entry);
+        return 0;
+    }
+    if (cache->size == cache->capacity) {
+        entry = chooseVictim(cache);
+        if (cache->evict != NULL) {
+            cache->evict(keyOf(cache, entry), valueOf(cache, entry), cache->evictContext);
+        }
+        release(cache, entry);
+    }
+    entry = gDLIST_ENTRY(cache->unused.next, cache_entry, link);
+    size_t slot = (size_t) ((char *) entry - cache->entries) / cache->slotSize;
+    if (gHashMapPut(cache->index, key, &slot) != 0) {
+        return gErrorCode;
+    }
+    gDListRemove(&entry->link);
+    memcpy(keyOf(cache, entry), key, cache->keySize);
+    memcpy(valueOf(cache, entry), value, cache->valueSize);
+    entry->used = 1;
+    // A new CLOCK entry has to be used again to get a second chance
+    entry->referenced = 0;
+    if (cache->policy == G_CACHE_LRU) {
+        gDListPushFront(&cache->order, &entry->link);
+    }
+    cache->size++;
+    return 0;
+}
+
+int gCacheRemove(gCache *cache, void *key) {
+    if (cache == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    size_t *slot = gHashMapGet(cache->index, key);
+    if (slot == NULL) {
+        gErrorCode = G_ENOITM;
+        return G_ENOITM;
+    }
+    release(cache, entryAt(cache, *slot));
+    return 0;
+}
+
+/*  ------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  ------------------------------- */
+
+static cache_entry *entryAt(gCache *cache, size_t slot) {
+    return (cache_entry *) (cache->entries + slot * cache->slotSize);
+}
+
+static void *keyOf(gCache *cache, cache_entry *entry) {
+    return (char *) entry + cache->keyOffset;
+}
+
+static void *valueOf(gCache *cache, cache_entry *entry) {
+    return (char *) entry + cache->valueOffset;
+}
+
+static void touch(gCache *cache, cache_entry *entry) {
+    if (cache->policy == G_CACHE_LRU) {
+        gDListMoveFront(&cache->order, &entry->link);
+    } else {
+        entry->referenced = 1;
+    }
+}
+
+static cache_entry *chooseVictim(gCache *cache) {
+    if (cache->policy == G_CACHE_LRU) {
+        return gDLIST_ENTRY(cache->order.prev, cache_entry, link);
+    }
+    // Ends within two turns, the first one clears every flag
+    for (;;) {
+        cache_entry *entry = entryAt(cache, cache->hand);
+        cache->hand = cache->hand + 1 < cache->capacity ? cache->hand + 1 : 0;
+        if (!entry->used) {
+            continue;
+        }
+        if (!entry->referenced) {
+            return entry;
+        }
+        entry->referenced = 0;
+    }
+}
+
+static void release(gCache *cache, cache_entry *entry) {
+    gHashMapRemove(cache->index, keyOf(cache, entry));
+    if (cache->policy == G_CACHE_LRU) {
+        gDListRemove(&entry->link);
+    }
+    entry->used = 0;
+    gDListPushFront(&cache->unused, &entry->link);
+    cache->size--;
+}
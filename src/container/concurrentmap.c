@@ -0,0 +1,494 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/concurrentmap.h>
+#include "internal.h"
+#include <pthread.h>
+#include <string.h>
+
+/* Control byte of an empty slot, used slots hold 7 bits of the hash */
+#define CTRL_EMPTY          0x80
+/* Initial number of slots of a shard */
+#define SHARD_DEFAULT_SLOTS 16
+/* Position returned when a key is not found */
+#define NOT_FOUND           ((size_t) -1)
+#define CACHE_LINE          64
+
+/*
+ * Slot array of a shard. A table is never modified once replaced by a
+ * bigger one, it stays on the retired list until the map is deleted.
+ */
+typedef struct table {
+    struct table *retired;
+    size_t capacity;
+    unsigned char *ctrl;
+    char *slots;
+} table_t;
+
+/* Every shard gets its own cache lines, writers of different shards must not collide */
+struct gConcurrentMapShard {
+    pthread_mutex_t lock;
+    /* Odd while a writer is modifying the shard */
+    unsigned int seq;
+    table_t *table;
+    size_t size;
+    /* valueSize bytes used by the writer holding the lock */
+    char *scratch;
+}
+#if defined(__GNUC__)
+__attribute__((aligned(CACHE_LINE)))
+#endif
+;
+
+typedef struct gConcurrentMapShard shard_t;
+
+/**
+ * Function: createTable
+ * ---------------------
+ * Allocate an empty table, control bytes and slots share its allocation.
+ *
+ * @param map           The map the table belongs to
+ * @param capacity      Number of slots, a power of two
+ *
+ * @return              The table, NULL in case of failure
+ */
+static table_t *createTable(gConcurrentMap *map, size_t capacity);
+
+/**
+ * Function: probe
+ * ---------------
+ * Find the slot holding a key. Also called by readers while the table
+ * may be modified, so it never runs more than one round of the table.
+ *
+ * @param map       The map
+ * @param table     The table to be searched
+ * @param key       The key
+ * @param hash      Hash of the key
+ *
+ * @return          Slot index, NOT_FOUND if not present
+ */
+static size_t probe(gConcurrentMap *map, table_t *table, void *key, uint64_t hash);
+
+/**
+ * Function: insertLocked
+ * ----------------------
+ * Store a key and its value in a slot, or in a new slot if index is
+ * NOT_FOUND, growing the table if needed. The shard lock must be held.
+ *
+ * @param map       The map
+ * @param shard     The shard of the key
+ * @param key       The key
+ * @param hash      Hash of the key
+ * @param index     Slot of the key as returned by probe
+ * @param value     The value
+ *
+ * @return          status code of operation
+ */
+static int insertLocked(gConcurrentMap *map, shard_t *shard, void *key, uint64_t hash,
+                        size_t index, void *value);
+
+/**
+ * Function: lookup
+ * ----------------
+ * Lock free read of a value, retried until no writer interfered.
+ *
+ * @param map       The map
+ * @param shard     The shard of the key
+ * @param key       The key
+ * @param hash      Hash of the key
+ * @param value     Receives the value, may be NULL
+ *
+ * @return          (1) if found, (0) if not
+ */
+static int lookup(gConcurrentMap *map, shard_t *shard, void *key, uint64_t hash, void *value);
+
+/*  ------------------------------- *
+ *
+ *  Small inline helpers.
+ *
+ *  ------------------------------- */
+
+static unsigned char h2(uint64_t hash) {
+    return (unsigned char) (hash & 0x7f);
+}
+
+static size_t h1(uint64_t hash) {
+    return (size_t) (hash >> 7);
+}
+
+static char *slotAt(gConcurrentMap *map, table_t *table, size_t index) {
+    return table->slots + index * map->slotSize;
+}
+
+static int keysEqual(gConcurrentMap *map, void *a, void *b) {
+    if (map->equal == NULL) {
+        return memcmp(a, b, map->keySize) == 0;
+    }
+    return map->equal(a, b) == 0;
+}
+
+static shard_t *shardOf(gConcurrentMap *map, uint64_t hash) {
+    if (map->nshards == 1) {
+        return map->shards;
+    }
+    return map->shards + (size_t) (hash >> map->shardShift);
+}
+
+static void cpuRelax(void) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#endif
+}
+
+/*
+ * Writers make the sequence odd before touching the shard and even again
+ * afterwards. The fence keeps the slot writes from becoming visible before
+ * the odd sequence, the release store keeps them from coming after the
+ * even one.
+ */
+static void writeBegin(shard_t *shard) {
+    __atomic_store_n(&shard->seq, shard->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void writeEnd(shard_t *shard) {
+    __atomic_store_n(&shard->seq, shard->seq + 1, __ATOMIC_RELEASE);
+}
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gConcurrentMap *gConcurrentMapCreate(size_t keySize, size_t valueSize, size_t nshards,
+                                     gHashFunc hash, cmpfunc_t equal) {
+    if (keySize == 0 || nshards > CONCURRENTMAP_MAX_SHARDS) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    gConcurrentMap *map = malloc(sizeof(gConcurrentMap));
+    if (map == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    if (nshards == 0) {
+        nshards = CONCURRENTMAP_DEFAULT_SHARDS;
+    }
+    map->nshards = 1;
+    map->shardShift = 64;
+    while (map->nshards < nshards) {
+        map->nshards <<= 1;
+        map->shardShift--;
+    }
+    size_t keyAlign = alignOf(keySize);
+    size_t valueAlign = valueSize > 0 ? alignOf(valueSize) : 1;
+    map->keySize = keySize;
+    map->valueSize = valueSize;
+    map->valueOffset = roundUp(keySize, valueAlign);
+    map->slotSize = roundUp(map->valueOffset + valueSize, keyAlign > valueAlign ? keyAlign : valueAlign);
+    map->hash = hash != NULL ? hash : gHashBytes;
+    map->equal = equal;
+
+    void *shards;
+    if (posix_memalign(&shards, CACHE_LINE, map->nshards * sizeof(shard_t)) != 0) {
+        free(map);
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    map->shards = (shard_t *) shards;
+    size_t i;
+    for (i = 0; i < map->nshards; i++) {
+        shard_t *shard = &map->shards[i];
+        pthread_mutex_init(&shard->lock, NULL);
+        shard->seq = 0;
+        shard->size = 0;
+        shard->table = createTable(map, SHARD_DEFAULT_SLOTS);
+        shard->scratch = malloc(valueSize > 0 ? valueSize : 1);
+        if (shard->table == NULL || shard->scratch == NULL) {
+            free(shard->table);
+            free(shard->scratch);
+            pthread_mutex_destroy(&shard->lock);
+            map->nshards = i;
+            gConcurrentMapDelete(map);
+            gErrorCode = G_ENOMEN;
+            return NULL;
+        }
+    }
+    return map;
+}
+
+void gConcurrentMapDelete(gConcurrentMap *map) {
+    if (map == NULL) {
+        return;
+    }
+    size_t i;
+    for (i = 0; i < map->nshards; i++) {
+        shard_t *shard = &map->shards[i];
+        table_t *table = shard->table;
+        while (table != NULL) {
+            table_t *older = table->retired;
+            free(table);
+            table = older;
+        }
+        free(shard->scratch);
+        pthread_mutex_destroy(&shard->lock);
+    }
+    free(map->shards);
+    free(map);
+}
+
+int gConcurrentMapGet(gConcurrentMap *map, void *key, void *value) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return 0;
+    }
+    uint64_t hash = map->hash(key, map->keySize);
+    return lookup(map, shardOf(map, hash), key, hash, value);
+}
+
+int gConcurrentMapPut(gConcurrentMap *map, void *key, void *value) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    uint64_t hash = map->hash(key, map->keySize);
+    shard_t *shard = shardOf(map, hash);
+    pthread_mutex_lock(&shard->lock);
+    size_t index = probe(map, shard->table, key, hash);
+    int status = insertLocked(map, shard, key, hash, index, value);
+    pthread_mutex_unlock(&shard->lock);
+    return status;
+}
+
+int gConcurrentMapRemove(gConcurrentMap *map, void *key) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    uint64_t hash = map->hash(key, map->keySize);
+    shard_t *shard = shardOf(map, hash);
+    pthread_mutex_lock(&shard->lock);
+    table_t *table = shard->table;
+    size_t hole = probe(map, table, key, hash);
+    if (hole == NOT_FOUND) {
+        pthread_mutex_unlock(&shard->lock);
+        gErrorCode = G_ENOITM;
+        return gErrorCode;
+    }
+    size_t mask = table->capacity - 1;
+    size_t next = hole;
+    writeBegin(shard);
+    // Backward shift deletion, as in hashmap.c
+    for (;;) {
+        next = (next + 1) & mask;
+        if (table->ctrl[next] == CTRL_EMPTY) {
+            break;
+        }
+        size_t home = h1(map->hash(slotAt(map, table, next), map->keySize)) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            __atomic_store_n(&table->ctrl[hole], table->ctrl[next], __ATOMIC_RELAXED);
+            memcpy(slotAt(map, table, hole), slotAt(map, table, next), map->slotSize);
+            hole = next;
+        }
+    }
+    __atomic_store_n(&table->ctrl[hole], CTRL_EMPTY, __ATOMIC_RELAXED);
+    writeEnd(shard);
+    __atomic_store_n(&shard->size, shard->size - 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&shard->lock);
+    return 0;
+}
+
+int gConcurrentMapUpsert(gConcurrentMap *map, void *key, gConcurrentUpdate update, void *ctx) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    uint64_t hash = map->hash(key, map->keySize);
+    shard_t *shard = shardOf(map, hash);
+    pthread_mutex_lock(&shard->lock);
+    size_t index = probe(map, shard->table, key, hash);
+    if (index != NOT_FOUND) {
+        memcpy(shard->scratch, slotAt(map, shard->table, index) + map->valueOffset, map->valueSize);
+    }
+    update(shard->scratch, index != NOT_FOUND, ctx);
+    int status = insertLocked(map, shard, key, hash, index, shard->scratch);
+    pthread_mutex_unlock(&shard->lock);
+    return status;
+}
+
+int gConcurrentMapComputeIfAbsent(gConcurrentMap *map, void *key, gConcurrentCompute compute,
+                                  void *ctx, void *value) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    uint64_t hash = map->hash(key, map->keySize);
+    shard_t *shard = shardOf(map, hash);
+    if (lookup(map, shard, key, hash, value)) {
+        return 0;
+    }
+    pthread_mutex_lock(&shard->lock);
+    int status = 0;
+    size_t index = probe(map, shard->table, key, hash);
+    if (index != NOT_FOUND) {
+        // Another thread created it since the lookup
+        if (value != NULL) {
+            memcpy(value, slotAt(map, shard->table, index) + map->valueOffset, map->valueSize);
+        }
+    } else if (compute(key, shard->scratch, ctx) != 0) {
+        gErrorCode = G_ENOITM;
+        status = gErrorCode;
+    } else {
+        status = insertLocked(map, shard, key, hash, index, shard->scratch);
+        if (status == 0 && value != NULL) {
+            memcpy(value, shard->scratch, map->valueSize);
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return status;
+}
+
+size_t gConcurrentMapSize(gConcurrentMap *map) {
+    size_t size = 0;
+    size_t i;
+    if (map == NULL) {
+        return 0;
+    }
+    for (i = 0; i < map->nshards; i++) {
+        size += __atomic_load_n(&map->shards[i].size, __ATOMIC_RELAXED);
+    }
+    return size;
+}
+
+/*  --------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  --------------------------------- */
+
+static table_t *createTable(gConcurrentMap *map, size_t capacity) {
+    size_t slotsOffset = roundUp(sizeof(table_t) + capacity, 16);
+    table_t *table = malloc(slotsOffset + capacity * map->slotSize);
+    if (table == NULL) {
+        return NULL;
+    }
+    table->retired = NULL;
+    table->capacity = capacity;
+    table->ctrl = (unsigned char *) (table + 1);
+    table->slots = (char *) table + slotsOffset;
+    memset(table->ctrl, CTRL_EMPTY, capacity);
+    return table;
+}
+
+static size_t probe(gConcurrentMap *map, table_t *table, void *key, uint64_t hash) {
+    size_t mask = table->capacity - 1;
+    size_t pos = h1(hash) & mask;
+    unsigned char tag = h2(hash);
+    size_t n;
+    for (n = 0; n < table->capacity; n++) {
+        unsigned char ctrl = __atomic_load_n(&table->ctrl[pos], __ATOMIC_RELAXED);
+        if (ctrl == CTRL_EMPTY) {
+            break;
+        }
+        if (ctrl == tag && keysEqual(map, key, slotAt(map, table, pos))) {
+            return pos;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return NOT_FOUND;
+}
+
+static int insertLocked(gConcurrentMap *map, shard_t *shard, void *key, uint64_t hash,
+                        size_t index, void *value) {
+    table_t *table = shard->table;
+    if (index != NOT_FOUND) {
+        writeBegin(shard);
+        memcpy(slotAt(map, table, index) + map->valueOffset, value, map->valueSize);
+        writeEnd(shard);
+        return 0;
+    }
+    // Keep the load factor at or below 7/8
+    if (shard->size + 1 > table->capacity - table->capacity / 8) {
+        table_t *bigger = createTable(map, table->capacity * 2);
+        if (bigger == NULL) {
+            gErrorCode = G_ENOMEN;
+            return gErrorCode;
+        }
+        // The new table is private until published, no need to fence its filling
+        size_t mask = bigger->capacity - 1;
+        size_t i;
+        for (i = 0; i < table->capacity; i++) {
+            if (table->ctrl[i] != CTRL_EMPTY) {
+                char *slot = slotAt(map, table, i);
+                size_t pos = h1(map->hash(slot, map->keySize)) & mask;
+                while (bigger->ctrl[pos] != CTRL_EMPTY) {
+                    pos = (pos + 1) & mask;
+                }
+                bigger->ctrl[pos] = table->ctrl[i];
+                memcpy(slotAt(map, bigger, pos), slot, map->slotSize);
+            }
+        }
+        bigger->retired = table;
+        writeBegin(shard);
+        __atomic_store_n(&shard->table, bigger, __ATOMIC_RELEASE);
+        writeEnd(shard);
+        table = bigger;
+    }
+    size_t mask = table->capacity - 1;
+    size_t pos = h1(hash) & mask;
+    while (table->ctrl[pos] != CTRL_EMPTY) {
+        pos = (pos + 1) & mask;
+    }
+    writeBegin(shard);
+    memcpy(slotAt(map, table, pos), key, map->keySize);
+    memcpy(slotAt(map, table, pos) + map->valueOffset, value, map->valueSize);
+    __atomic_store_n(&table->ctrl[pos], h2(hash), __ATOMIC_RELAXED);
+    writeEnd(shard);
+    __atomic_store_n(&shard->size, shard->size + 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+static int lookup(gConcurrentMap *map, shard_t *shard, void *key, uint64_t hash, void *value) {
+    for (;;) {
+        unsigned int seq = __atomic_load_n(&shard->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1) {
+            cpuRelax();
+            continue;
+        }
+        table_t *table = __atomic_load_n(&shard->table, __ATOMIC_ACQUIRE);
+        /*
+         * The slot may be overwritten while it is compared or copied, the
+         * sequence check below discards whatever was read in that case.
+         */
+        size_t index = probe(map, table, key, hash);
+        if (index != NOT_FOUND && value != NULL) {
+            memcpy(value, slotAt(map, table, index) + map->valueOffset, map->valueSize);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&shard->seq, __ATOMIC_RELAXED) == seq) {
+            return index != NOT_FOUND;
+        }
+    }
+}
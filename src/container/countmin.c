@@ -0,0 +1,455 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/countmin.h>
+#include "internal.h"
+#include <generic/hash.h>
+#include <math.h>
+#include <string.h>
+
+/* Keys hashed together by the batch function */
+#define BATCH_SIZE      64
+#define MAX_DEPTH       32
+
+#define SERIAL_MAGIC    "GCMS"
+#define SERIAL_VERSION  1
+#define SERIAL_HEADER   56
+
+/**
+ * Function: allocate
+ * ------------------
+ * Create a zeroed sketch of the given dimensions
+ */
+static gCountMin *allocate(size_t keySize, size_t width, size_t depth, int conservative, size_t topK);
+
+/**
+ * Function: column
+ * ----------------
+ * Counter of a key in a row, from two halves of its hash combined
+ * differently for every row
+ */
+static size_t column(gCountMin *cms, uint64_t hash, size_t row);
+
+/**
+ * Function: addHash
+ * -----------------
+ * Add occurrences of a key and update the heavy hitters
+ *
+ * @return          status code of operation
+ */
+static int addHash(gCountMin *cms, void *key, uint64_t hash, uint32_t count);
+
+static uint64_t estimateHash(gCountMin *cms, uint64_t hash);
+
+/**
+ * Function: offerHeavy
+ * --------------------
+ * Track a key with its new estimate if it is one of the topK largest
+ *
+ * @return          status code of operation
+ */
+static int offerHeavy(gCountMin *cms, void *key, uint64_t estimate);
+
+static char *heavyAt(gCountMin *cms, size_t pos);
+static uint64_t heavyCount(gCountMin *cms, size_t pos);
+static void heavySwap(gCountMin *cms, size_t a, size_t b);
+static void siftUp(gCountMin *cms, size_t pos);
+static void siftDown(gCountMin *cms, size_t pos);
+static int compareHeavy(const void *a, const void *b);
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gCountMin *gCountMinCreate(size_t keySize, double epsilon, double delta, int conservative, size_t topK) {
+    if (keySize == 0 || !(epsilon > 0 && epsilon < 1) || !(delta > 0 && delta < 1)) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    size_t width = 1;
+    while ((double) width < M_E / epsilon) {
+        width <<= 1;
+    }
+    size_t depth = (size_t) ceil(log(1 / delta));
+    if (depth < 1) depth = 1;
+    if (depth > MAX_DEPTH) depth = MAX_DEPTH;
+    return allocate(keySize, width, depth, conservative, topK);
+}
+
+void gCountMinDelete(gCountMin *cms) {
+    if (cms == NULL) {
+        return;
+    }
+    gHashMapDelete(cms->heavyIndex);
+    free(cms->heavy);
+    free(cms->counters);
+    free(cms);
+}
+
+int gCountMinAdd(gCountMin *cms, void *key, uint32_t count) {
+    if (cms == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    return addHash(cms, key, gHashBytes(key, cms->keySize), count);
+}
+
+int gCountMinAddBatch(gCountMin *cms, void *keys, size_t n) {
+    if (cms == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    uint64_t hashes[BATCH_SIZE];
+    char *ptr = (char *) keys;
+    size_t done, i;
+    for (done = 0; done < n; done += BATCH_SIZE) {
+        size_t count = n - done < BATCH_SIZE ? n - done : BATCH_SIZE;
+        gHashBatch(ptr + done * cms->keySize, count, cms->keySize, hashes);
+        for (i = 0; i < count; i++) {
+            int status = addHash(cms, ptr + (done + i) * cms->keySize, hashes[i], 1);
+            if (status != 0) {
+                return status;
+            }
+        }
+    }
+    return 0;
+}
+
+uint64_t gCountMinEstimate(gCountMin *cms, void *key) {
+    if (cms == NULL) {
+        gErrorCode = G_EINVLD;
+        return 0;
+    }
+    return estimateHash(cms, gHashBytes(key, cms->keySize));
+}
+
+size_t gCountMinTopK(gCountMin *cms, void *keys, uint64_t *counts) {
+    if (cms == NULL) {
+        gErrorCode = G_EINVLD;
+        return 0;
+    }
+    if (cms->heavySize == 0) {
+        return 0;
+    }
+    char *sorted = malloc(cms->heavySize * cms->heavyEntrySize);
+    if (sorted == NULL) {
+        gErrorCode = G_ENOMEN;
+        return 0;
+    }
+    memcpy(sorted, cms->heavy, cms->heavySize * cms->heavyEntrySize);
+    qsort(sorted, cms->heavySize, cms->heavyEntrySize, compareHeavy);
+    size_t i;
+    for (i = 0; i < cms->heavySize; i++) {
+        char *entry = sorted + i * cms->heavyEntrySize;
+        memcpy((char *) keys + i * cms->keySize, entry + sizeof(uint64_t), cms->keySize);
+        if (counts != NULL) {
+            memcpy(&counts[i], entry, sizeof(uint64_t));
+        }
+    }
+    free(sorted);
+    return cms->heavySize;
+}
+
+int gCountMinMerge(gCountMin *dst, gCountMin *src) {
+    if (dst == NULL || src == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    if (dst->width != src->width || dst->depth != src->depth || dst->keySize != src->keySize) {
+        gErrorCode = G_EINVAL;
+        return G_EINVAL;
+    }
+    size_t i;
+    for (i = 0; i < dst->width * dst->depth; i++) {
+        uint32_t sum = dst->counters[i] + src->counters[i];
+        // Saturate rather than wrap around
+        dst->counters[i] = sum < dst->counters[i] ? UINT32_MAX : sum;
+    }
+    dst->total += src->total;
+    // Estimates of keys already tracked by dst may have grown too
+    for (i = 0; i < dst->heavySize; i++) {
+        char *key = heavyAt(dst, i) + sizeof(uint64_t);
+        uint64_t estimate = estimateHash(dst, gHashBytes(key, dst->keySize));
+        memcpy(heavyAt(dst, i), &estimate, sizeof(uint64_t));
+    }
+    for (i = dst->heavySize / 2; i-- > 0;) {
+        siftDown(dst, i);
+    }
+    for (i = 0; i < src->heavySize; i++) {
+        char *key = heavyAt(src, i) + sizeof(uint64_t);
+        int status = offerHeavy(dst, key, estimateHash(dst, gHashBytes(key, dst->keySize)));
+        if (status != 0) {
+            return status;
+        }
+    }
+    return 0;
+}
+
+size_t gCountMinSerialize(gCountMin *cms, void *buf, size_t size) {
+    size_t ncounters = cms->width * cms->depth;
+    size_t needed = SERIAL_HEADER + ncounters * sizeof(uint32_t)
+                    + cms->heavySize * (sizeof(uint64_t) + cms->keySize);
+    if (buf == NULL || size < needed) {
+        return needed;
+    }
+    unsigned char *p = (unsigned char *) buf;
+    memcpy(p, SERIAL_MAGIC, 4);
+    putU32(p + 4, SERIAL_VERSION);
+    putU32(p + 8, (uint32_t) cms->depth);
+    putU32(p + 12, cms->conservative != 0);
+    putU64(p + 16, cms->keySize);
+    putU64(p + 24, cms->width);
+    putU64(p + 32, cms->total);
+    putU64(p + 40, cms->topK);
+    putU64(p + 48, cms->heavySize);
+    p += SERIAL_HEADER;
+    size_t i;
+    for (i = 0; i < ncounters; i++) {
+        putU32(p, cms->counters[i]);
+        p += sizeof(uint32_t);
+    }
+    for (i = 0; i < cms->heavySize; i++) {
+        putU64(p, heavyCount(cms, i));
+        memcpy(p + sizeof(uint64_t), heavyAt(cms, i) + sizeof(uint64_t), cms->keySize);
+        p += sizeof(uint64_t) + cms->keySize;
+    }
+    return needed;
+}
+
+gCountMin *gCountMinDeserialize(const void *buf, size_t size) {
+    const unsigned char *p = (const unsigned char *) buf;
+    if (buf == NULL || size < SERIAL_HEADER || memcmp(p, SERIAL_MAGIC, 4) != 0
+        || getU32(p + 4) != SERIAL_VERSION) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    uint64_t depth = getU32(p + 8);
+    int conservative = (int) getU32(p + 12);
+    uint64_t keySize = getU64(p + 16);
+    uint64_t width = getU64(p + 24);
+    uint64_t total = getU64(p + 32);
+    uint64_t topK = getU64(p + 40);
+    uint64_t heavySize = getU64(p + 48);
+    size_t rest = size - SERIAL_HEADER;
+    // Each field is checked against the bytes left before it is used in a size
+    if (depth < 1 || depth > MAX_DEPTH || keySize == 0 || keySize > rest || width == 0
+        || (width & (width - 1)) != 0 || width > rest / sizeof(uint32_t) / depth || heavySize > topK
+        || heavySize > (rest - width * depth * sizeof(uint32_t)) / (sizeof(uint64_t) + (size_t) keySize)) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    gCountMin *cms = allocate((size_t) keySize, (size_t) width, (size_t) depth, conservative, (size_t) topK);
+    if (cms == NULL) {
+        return NULL;
+    }
+    cms->total = total;
+    p += SERIAL_HEADER;
+    size_t i;
+    for (i = 0; i < cms->width * cms->depth; i++) {
+        cms->counters[i] = getU32(p);
+        p += sizeof(uint32_t);
+    }
+    for (i = 0; i < heavySize; i++) {
+        if (offerHeavy(cms, (void *) (p + sizeof(uint64_t)), getU64(p)) != 0) {
+            gCountMinDelete(cms);
+            return NULL;
+        }
+        p += sizeof(uint64_t) + cms->keySize;
+    }
+    return cms;
+}
+
+/*  --------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  --------------------------------- */
+
+static gCountMin *allocate(size_t keySize, size_t width, size_t depth, int conservative, size_t topK) {
+    size_t heavyEntrySize = (sizeof(uint64_t) + keySize + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+    if (topK >= SIZE_MAX / heavyEntrySize) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    gCountMin *cms = malloc(sizeof(gCountMin));
+    if (cms == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    cms->counters = calloc(width * depth, sizeof(uint32_t));
+    cms->heavyEntrySize = heavyEntrySize;
+    // One spare entry is used as scratch space by heavySwap
+    cms->heavy = topK > 0 ? malloc((topK + 1) * cms->heavyEntrySize) : NULL;
+    cms->heavyIndex = topK > 0 ? gHashMapCreate(keySize, sizeof(size_t), NULL, NULL) : NULL;
+    if (cms->counters == NULL || (topK > 0 && (cms->heavy == NULL || cms->heavyIndex == NULL
+                                               || gHashMapReserve(cms->heavyIndex, topK) != 0))) {
+        gHashMapDelete(cms->heavyIndex);
+        free(cms->heavy);
+        free(cms->counters);
+        free(cms);
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    cms->width = width;
+    cms->depth = depth;
+    cms->keySize = keySize;
+    cms->total = 0;
+    cms->conservative = conservative;
+    cms->heavySize = 0;
+    cms->topK = topK;
+    return cms;
+}
+
+static size_t column(gCountMin *cms, uint64_t hash, size_t row) {
+    uint32_t h1 = (uint32_t) hash;
+    uint32_t h2 = (uint32_t) (hash >> 32) | 1;
+    return (size_t) (h1 + (uint32_t) row * h2) & (cms->width - 1);
+}
+
+static int addHash(gCountMin *cms, void *key, uint64_t hash, uint32_t count) {
+    uint32_t *counters[MAX_DEPTH];
+    uint32_t smallest = UINT32_MAX;
+    size_t row;
+    for (row = 0; row < cms->depth; row++) {
+        counters[row] = cms->counters + row * cms->width + column(cms, hash, row);
+        if (*counters[row] < smallest) {
+            smallest = *counters[row];
+        }
+    }
+    uint32_t estimate = smallest + count < smallest ? UINT32_MAX : smallest + count;
+    for (row = 0; row < cms->depth; row++) {
+        if (cms->conservative) {
+            if (*counters[row] < estimate) {
+                *counters[row] = estimate;
+            }
+        } else {
+            uint32_t sum = *counters[row] + count;
+            *counters[row] = sum < count ? UINT32_MAX : sum;
+        }
+    }
+    cms->total += count;
+    if (cms->topK == 0) {
+        return 0;
+    }
+    // Without conservative update every counter grew by count, so did the smallest
+    return offerHeavy(cms, key, estimate);
+}
+
+static uint64_t estimateHash(gCountMin *cms, uint64_t hash) {
+    uint32_t smallest = UINT32_MAX;
+    size_t row;
+    for (row = 0; row < cms->depth; row++) {
+        uint32_t value = cms->counters[row * cms->width + column(cms, hash, row)];
+        if (value < smallest) {
+            smallest = value;
+        }
+    }
+    return smallest;
+}
+
+static int offerHeavy(gCountMin *cms, void *key, uint64_t estimate) {
+    if (cms->topK == 0) {
+        return 0;
+    }
+    size_t *pos = gHashMapGet(cms->heavyIndex, key);
+    if (pos != NULL) {
+        memcpy(heavyAt(cms, *pos), &estimate, sizeof(uint64_t));
+        siftDown(cms, *pos);
+        return 0;
+    }
+    size_t slot;
+    if (cms->heavySize < cms->topK) {
+        slot = cms->heavySize++;
+    } else if (estimate > heavyCount(cms, 0)) {
+        // Replace the smallest heavy hitter
+        gHashMapRemove(cms->heavyIndex, heavyAt(cms, 0) + sizeof(uint64_t));
+        slot = 0;
+    } else {
+        return 0;
+    }
+    memcpy(heavyAt(cms, slot), &estimate, sizeof(uint64_t));
+    memcpy(heavyAt(cms, slot) + sizeof(uint64_t), key, cms->keySize);
+    if (gHashMapPut(cms->heavyIndex, key, &slot) != 0) {
+        return gErrorCode;
+    }
+    if (slot == 0) {
+        siftDown(cms, 0);
+    } else {
+        siftUp(cms, slot);
+    }
+    return 0;
+}
+
+static char *heavyAt(gCountMin *cms, size_t pos) {
+    return cms->heavy + pos * cms->heavyEntrySize;
+}
+
+static uint64_t heavyCount(gCountMin *cms, size_t pos) {
+    uint64_t count;
+    memcpy(&count, heavyAt(cms, pos), sizeof(uint64_t));
+    return count;
+}
+
+static void heavySwap(gCountMin *cms, size_t a, size_t b) {
+    char *scratch = heavyAt(cms, cms->topK);
+    memcpy(scratch, heavyAt(cms, a), cms->heavyEntrySize);
+    memcpy(heavyAt(cms, a), heavyAt(cms, b), cms->heavyEntrySize);
+    memcpy(heavyAt(cms, b), scratch, cms->heavyEntrySize);
+    *(size_t *) gHashMapGet(cms->heavyIndex, heavyAt(cms, a) + sizeof(uint64_t)) = a;
+    *(size_t *) gHashMapGet(cms->heavyIndex, heavyAt(cms, b) + sizeof(uint64_t)) = b;
+}
+
+static void siftUp(gCountMin *cms, size_t pos) {
+    while (pos > 0 && heavyCount(cms, (pos - 1) / 2) > heavyCount(cms, pos)) {
+        heavySwap(cms, pos, (pos - 1) / 2);
+        pos = (pos - 1) / 2;
+    }
+}
+
+static void siftDown(gCountMin *cms, size_t pos) {
+    for (;;) {
+        size_t smallest = pos;
+        size_t child = 2 * pos + 1;
+        if (child < cms->heavySize && heavyCount(cms, child) < heavyCount(cms, smallest)) {
+            smallest = child;
+        }
+        if (child + 1 < cms->heavySize && heavyCount(cms, child + 1) < heavyCount(cms, smallest)) {
+            smallest = child + 1;
+        }
+        if (smallest == pos) {
+            return;
+        }
+        heavySwap(cms, pos, smallest);
+        pos = smallest;
+    }
+}
+
+static int compareHeavy(const void *a, const void *b) {
+    uint64_t x, y;
+    memcpy(&x, a, sizeof(uint64_t));
+    memcpy(&y, b, sizeof(uint64_t));
+    return (x < y) - (x > y);
+}
@@ -0,0 +1,329 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/cuckoo.h>
+#include <generic/hash.h>
+#include <string.h>
+
+/* Relocations tried before an insertion gives up */
+#define MAX_KICKS       500
+/* Buckets are read as one 64 bit word, the last one needs this much slack */
+#define BUCKET_PADDING  sizeof(uint64_t)
+
+#if defined(__GNUC__)
+#define CTZ64(x)        __builtin_ctzll(x)
+#else
+static int CTZ64(uint64_t x) {
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+}
+#endif
+
+/**
+ * Function: laneOnes
+ * ------------------
+ * Word with the lowest bit of each of the 4 slots of a bucket set
+ *
+ * @param bits      Bits per fingerprint
+ */
+static uint64_t laneOnes(unsigned int bits);
+
+/**
+ * Function: zeroLanes
+ * -------------------
+ * Find the empty slots of a bucket word, all 4 at once. The top bit of
+ * every slot that is zero is set in the result, other bits are clear.
+ *
+ * @param word      Bucket word
+ * @param bits      Bits per fingerprint
+ */
+static uint64_t zeroLanes(uint64_t word, unsigned int bits);
+
+/**
+ * Function: matchLanes
+ * --------------------
+ * Find the slots of a bucket word holding a fingerprint, same result
+ * format as zeroLanes
+ */
+static uint64_t matchLanes(uint64_t word, uint32_t fp, unsigned int bits);
+
+static uint64_t loadBucket(gCuckoo *filter, size_t index);
+static void storeBucket(gCuckoo *filter, size_t index, uint64_t word);
+
+/**
+ * Function: fingerprintOf
+ * -----------------------
+ * Fingerprint of a key from the high half of its hash, never 0 since 0
+ * marks an empty slot
+ */
+static uint32_t fingerprintOf(gCuckoo *filter, uint64_t hash);
+
+/**
+ * Function: altBucket
+ * -------------------
+ * The other bucket of a fingerprint. Only depends on the bucket and the
+ * fingerprint, so a stored fingerprint can be moved without its key.
+ */
+static size_t altBucket(gCuckoo *filter, size_t index, uint32_t fp);
+
+/**
+ * Function: tryPlace
+ * ------------------
+ * Put a fingerprint in an empty slot of a bucket
+ *
+ * @return          (1) if there was room
+ */
+static int tryPlace(gCuckoo *filter, size_t index, uint32_t fp);
+
+/**
+ * Function: insertFingerprint
+ * ---------------------------
+ * Place a fingerprint in one of its two buckets, moving others out of the
+ * way if both are full. The last fingerprint displaced when giving up is
+ * kept as the victim.
+ */
+static void insertFingerprint(gCuckoo *filter, size_t index, uint32_t fp);
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gCuckoo *gCuckooCreate(size_t keySize, size_t capacity, unsigned int fingerprintBits) {
+    if (keySize == 0 || (fingerprintBits != 8 && fingerprintBits != 12 && fingerprintBits != 16)) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    size_t nbuckets = 1;
+    while (nbuckets * CUCKOO_BUCKET_SLOTS < capacity) {
+        nbuckets <<= 1;
+    }
+    // Insertions start failing past 95% occupancy
+    if ((double) capacity / (double) (nbuckets * CUCKOO_BUCKET_SLOTS) > 0.95) {
+        nbuckets <<= 1;
+    }
+    gCuckoo *filter = malloc(sizeof(gCuckoo));
+    if (filter == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    filter->bucketBytes = CUCKOO_BUCKET_SLOTS * fingerprintBits / 8;
+    filter->buckets = calloc(nbuckets * filter->bucketBytes + BUCKET_PADDING, 1);
+    if (filter->buckets == NULL) {
+        free(filter);
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    filter->nbuckets = nbuckets;
+    filter->fingerprintBits = fingerprintBits;
+    filter->keySize = keySize;
+    filter->count = 0;
+    filter->victim = 0;
+    filter->victimBucket = 0;
+    filter->random = 0x2545f4914f6cdd1dULL;
+    return filter;
+}
+
+void gCuckooDelete(gCuckoo *filter) {
+    if (filter == NULL) {
+        return;
+    }
+    free(filter->buckets);
+    free(filter);
+}
+
+int gCuckooAdd(gCuckoo *filter, void *key) {
+    if (filter == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    if (filter->victim != 0) {
+        gErrorCode = G_EFULL;
+        return G_EFULL;
+    }
+    uint64_t hash = gHashBytes(key, filter->keySize);
+    uint32_t fp = fingerprintOf(filter, hash);
+    insertFingerprint(filter, hash & (filter->nbuckets - 1), fp);
+    filter->count++;
+    return 0;
+}
+
+int gCuckooContains(gCuckoo *filter, void *key) {
+    if (filter == NULL) {
+        gErrorCode = G_EINVLD;
+        return 0;
+    }
+    uint64_t hash = gHashBytes(key, filter->keySize);
+    uint32_t fp = fingerprintOf(filter, hash);
+    size_t i1 = hash & (filter->nbuckets - 1);
+    size_t i2 = altBucket(filter, i1, fp);
+    if (matchLanes(loadBucket(filter, i1), fp, filter->fingerprintBits)
+        || matchLanes(loadBucket(filter, i2), fp, filter->fingerprintBits)) {
+        return 1;
+    }
+    return filter->victim == fp && (filter->victimBucket == i1 || filter->victimBucket == i2);
+}
+
+int gCuckooRemove(gCuckoo *filter, void *key) {
+    if (filter == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    unsigned int bits = filter->fingerprintBits;
+    uint64_t hash = gHashBytes(key, filter->keySize);
+    uint32_t fp = fingerprintOf(filter, hash);
+    size_t buckets[2];
+    buckets[0] = hash & (filter->nbuckets - 1);
+    buckets[1] = altBucket(filter, buckets[0], fp);
+    if (filter->victim == fp && (filter->victimBucket == buckets[0] || filter->victimBucket == buckets[1])) {
+        filter->victim = 0;
+        filter->count--;
+        return 0;
+    }
+    int i;
+    for (i = 0; i < 2; i++) {
+        uint64_t word = loadBucket(filter, buckets[i]);
+        uint64_t match = matchLanes(word, fp, bits);
+        if (match) {
+            unsigned int lane = (unsigned int) CTZ64(match) / bits;
+            word &= ~((((uint64_t) 1 << bits) - 1) << (lane * bits));
+            storeBucket(filter, buckets[i], word);
+            filter->count--;
+            // The freed slot may make room for the victim
+            if (filter->victim != 0) {
+                uint32_t victim = filter->victim;
+                filter->victim = 0;
+                insertFingerprint(filter, filter->victimBucket, victim);
+            }
+            return 0;
+        }
+    }
+    gErrorCode = G_ENOITM;
+    return G_ENOITM;
+}
+
+/*  ------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  ------------------------------- */
+
+static uint64_t laneOnes(unsigned int bits) {
+    return 1 | (uint64_t) 1 << bits | (uint64_t) 1 << (2 * bits) | (uint64_t) 1 << (3 * bits);
+}
+
+static uint64_t zeroLanes(uint64_t word, unsigned int bits) {
+    uint64_t low = laneOnes(bits) * ((((uint64_t) 1) << (bits - 1)) - 1);
+    uint64_t high = laneOnes(bits) << (bits - 1);
+    // Adding the low bits of each slot carries into its top bit unless the
+    // slot is all zeros, and the carry never crosses into the next slot
+    return ~(((word & low) + low) | word) & high;
+}
+
+static uint64_t matchLanes(uint64_t word, uint32_t fp, unsigned int bits) {
+    return zeroLanes(word ^ (laneOnes(bits) * fp), bits);
+}
+
+static uint64_t loadBucket(gCuckoo *filter, size_t index) {
+    uint64_t word;
+    memcpy(&word, filter->buckets + index * filter->bucketBytes, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    if (filter->bucketBytes < sizeof(word)) {
+        word &= ((uint64_t) 1 << (filter->bucketBytes * 8)) - 1;
+    }
+    return word;
+}
+
+static void storeBucket(gCuckoo *filter, size_t index, uint64_t word) {
+    unsigned char *ptr = filter->buckets + index * filter->bucketBytes;
+    uint64_t old;
+    memcpy(&old, ptr, sizeof(old));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    old = __builtin_bswap64(old);
+#endif
+    // Keep the bytes of the next bucket sharing the word
+    if (filter->bucketBytes < sizeof(word)) {
+        uint64_t mask = ((uint64_t) 1 << (filter->bucketBytes * 8)) - 1;
+        word = (old & ~mask) | (word & mask);
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    memcpy(ptr, &word, sizeof(word));
+}
+
+static uint32_t fingerprintOf(gCuckoo *filter, uint64_t hash) {
+    uint32_t fp = (uint32_t) (hash >> 32) & ((1u << filter->fingerprintBits) - 1);
+    return fp != 0 ? fp : 1;
+}
+
+static size_t altBucket(gCuckoo *filter, size_t index, uint32_t fp) {
+    return (index ^ (size_t) gHashU32(fp)) & (filter->nbuckets - 1);
+}
+
+static int tryPlace(gCuckoo *filter, size_t index, uint32_t fp) {
+    unsigned int bits = filter->fingerprintBits;
+    uint64_t word = loadBucket(filter, index);
+    uint64_t empty = zeroLanes(word, bits);
+    if (!empty) {
+        return 0;
+    }
+    unsigned int lane = (unsigned int) CTZ64(empty) / bits;
+    storeBucket(filter, index, word | (uint64_t) fp << (lane * bits));
+    return 1;
+}
+
+static void insertFingerprint(gCuckoo *filter, size_t index, uint32_t fp) {
+    unsigned int bits = filter->fingerprintBits;
+    uint64_t mask = ((uint64_t) 1 << bits) - 1;
+    if (tryPlace(filter, index, fp)) {
+        return;
+    }
+    index = altBucket(filter, index, fp);
+    int kicks;
+    for (kicks = 0; kicks < MAX_KICKS; kicks++) {
+        if (tryPlace(filter, index, fp)) {
+            return;
+        }
+        // Swap with a random slot and move the evicted fingerprint along
+        filter->random ^= filter->random << 13;
+        filter->random ^= filter->random >> 7;
+        filter->random ^= filter->random << 17;
+        unsigned int lane = (unsigned int) (filter->random >> 62) * bits;
+        uint64_t word = loadBucket(filter, index);
+        uint32_t evicted = (uint32_t) ((word >> lane) & mask);
+        storeBucket(filter, index, (word & ~(mask << lane)) | (uint64_t) fp << lane);
+        fp = evicted;
+        index = altBucket(filter, index, fp);
+    }
+    filter->victim = fp;
+    filter->victimBucket = index;
+}
@@ -0,0 +1,382 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/hashmap.h>
+#include "internal.h"
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASHMAP_SSE2
+#endif
+
+/* Number of control bytes probed at once */
+#define GROUP_WIDTH     16
+/* Control byte of an empty slot, used slots hold 7 bits of the hash */
+#define CTRL_EMPTY      0x80
+/* Position returned when a key is not found */
+#define NOT_FOUND       ((size_t) -1)
+
+/**
+ * Function: matchByte
+ * -------------------
+ * Compare a group of control bytes with a value
+ *
+ * @param group     First control byte of the group
+ * @param value     Value to be looked for
+ *
+ * @return          Bit i is set if group[i] == value
+ */
+static uint32_t matchByte(const unsigned char *group, unsigned char value);
+
+/**
+ * Function: findKey
+ * -----------------
+ * Probe for the slot holding a key
+ *
+ * @param map       The hash map
+ * @param key       The key to be looked for
+ * @param hash      Hash of the key
+ *
+ * @return          Slot index, NOT_FOUND if not present
+ */
+static size_t findKey(gHashMap *map, void *key, uint64_t hash);
+
+/**
+ * Function: findEmpty
+ * -------------------
+ * Find the first empty slot on the probe sequence of a hash.
+ * There is always one since the map is never completely full.
+ */
+static size_t findEmpty(gHashMap *map, uint64_t hash);
+
+/**
+ * Function: resize
+ * ----------------
+ * Move all the entries into a new slot array
+ *
+ * @param map           The hash map
+ * @param capacity      New number of slots, a power of two
+ *
+ * @return              status code of operation
+ */
+static int resize(gHashMap *map, size_t capacity);
+
+/*  ------------------------------- *
+ *
+ *  Small inline helpers.
+ *
+ *  ------------------------------- */
+
+static int countTrailingZeros(uint32_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    int n = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static unsigned char h2(uint64_t hash) {
+    return (unsigned char) (hash & 0x7f);
+}
+
+static size_t h1(uint64_t hash) {
+    return (size_t) (hash >> 7);
+}
+
+static char *slotAt(gHashMap *map, size_t index) {
+    return map->slots + index * map->slotSize;
+}
+
+static uint64_t hashKey(gHashMap *map, void *key) {
+    return map->hash(key, map->keySize);
+}
+
+static int keysEqual(gHashMap *map, void *a, void *b) {
+    if (map->equal == NULL) {
+        return memcmp(a, b, map->keySize) == 0;
+    }
+    return map->equal(a, b) == 0;
+}
+
+/* Set a control byte and its copy past the end of the array */
+static void setCtrl(gHashMap *map, size_t index, unsigned char value) {
+    map->ctrl[index] = value;
+    if (index < GROUP_WIDTH - 1) {
+        map->ctrl[map->capacity + index] = value;
+    }
+}
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gHashMap *gHashMapCreate(size_t keySize, size_t valueSize, gHashFunc hash, cmpfunc_t equal) {
+    if (keySize == 0) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    gHashMap *map = malloc(sizeof(gHashMap));
+    if (map == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    size_t keyAlign = alignOf(keySize);
+    size_t valueAlign = valueSize > 0 ? alignOf(valueSize) : 1;
+    map->keySize = keySize;
+    map->valueSize = valueSize;
+    map->valueOffset = roundUp(keySize, valueAlign);
+    map->slotSize = roundUp(map->valueOffset + valueSize, keyAlign > valueAlign ? keyAlign : valueAlign);
+    map->hash = hash != NULL ? hash : gHashBytes;
+    map->equal = equal;
+    map->ctrl = NULL;
+    map->slots = NULL;
+    map->capacity = 0;
+    map->size = 0;
+    if (resize(map, HASHMAP_DEFAULT_SLOTS) != 0) {
+        free(map);
+        return NULL;
+    }
+    return map;
+}
+
+void gHashMapDelete(gHashMap *map) {
+    if (map == NULL) {
+        return;
+    }
+    free(map->ctrl);
+    free(map->slots);
+    free(map);
+}
+
+int gHashMapPut(gHashMap *map, void *key, void *value) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    uint64_t hash = hashKey(map, key);
+    size_t index = findKey(map, key, hash);
+    if (index == NOT_FOUND) {
+        if (gHashMapReserve(map, map->size + 1) != 0) {
+            return gErrorCode;
+        }
+        index = findEmpty(map, hash);
+        setCtrl(map, index, h2(hash));
+        memcpy(slotAt(map, index), key, map->keySize);
+        map->size++;
+    }
+    if (map->valueSize > 0) {
+        memcpy(slotAt(map, index) + map->valueOffset, value, map->valueSize);
+    }
+    return 0;
+}
+
+void *gHashMapGet(gHashMap *map, void *key) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return NULL;
+    }
+    size_t index = findKey(map, key, hashKey(map, key));
+    if (index == NOT_FOUND) {
+        return NULL;
+    }
+    return slotAt(map, index) + map->valueOffset;
+}
+
+int gHashMapContains(gHashMap *map, void *key) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return 0;
+    }
+    return findKey(map, key, hashKey(map, key)) != NOT_FOUND;
+}
+
+int gHashMapRemove(gHashMap *map, void *key) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    size_t hole = findKey(map, key, hashKey(map, key));
+    if (hole == NOT_FOUND) {
+        gErrorCode = G_ENOITM;
+        return gErrorCode;
+    }
+    size_t mask = map->capacity - 1;
+    size_t next = hole;
+    /*
+     * Backward shift: move back every following entry of the cluster that
+     * would still be reachable from its home slot once placed in the hole.
+     */
+    for (;;) {
+        next = (next + 1) & mask;
+        if (map->ctrl[next] == CTRL_EMPTY) {
+            break;
+        }
+        size_t home = h1(hashKey(map, slotAt(map, next))) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            setCtrl(map, hole, map->ctrl[next]);
+            memcpy(slotAt(map, hole), slotAt(map, next), map->slotSize);
+            hole = next;
+        }
+    }
+    setCtrl(map, hole, CTRL_EMPTY);
+    map->size--;
+    return 0;
+}
+
+int gHashMapReserve(gHashMap *map, size_t n) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    // Keep the load factor at or below 7/8
+    size_t capacity = map->capacity;
+    while (n > capacity - capacity / 8) {
+        if (capacity > SIZE_MAX / 2) {
+            gErrorCode = G_ENOMEN;
+            return gErrorCode;
+        }
+        capacity *= 2;
+    }
+    if (capacity == map->capacity) {
+        return 0;
+    }
+    return resize(map, capacity);
+}
+
+int gHashMapIterate(gHashMap *map, size_t *pos, void **key, void **value) {
+    if (map == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    while (*pos < map->capacity) {
+        size_t index = (*pos)++;
+        if (map->ctrl[index] != CTRL_EMPTY) {
+            *key = slotAt(map, index);
+            if (value != NULL) {
+                *value = slotAt(map, index) + map->valueOffset;
+            }
+            return 0;
+        }
+    }
+    gErrorCode = G_EITMEND;
+    return gErrorCode;
+}
+
+/*  --------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  --------------------------------- */
+
+static uint32_t matchByte(const unsigned char *group, unsigned char value) {
+#ifdef HASHMAP_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i *) group);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char) value)));
+#else
+    uint32_t mask = 0;
+    int i;
+    for (i = 0; i < GROUP_WIDTH; i++) {
+        mask |= (uint32_t) (group[i] == value) << i;
+    }
+    return mask;
+#endif
+}
+
+static size_t findKey(gHashMap *map, void *key, uint64_t hash) {
+    size_t mask = map->capacity - 1;
+    size_t pos = h1(hash) & mask;
+    unsigned char tag = h2(hash);
+    for (;;) {
+        const unsigned char *group = map->ctrl + pos;
+        uint32_t match = matchByte(group, tag);
+        uint32_t empty = matchByte(group, CTRL_EMPTY);
+        if (empty != 0) {
+            // Linear probing: nothing past the first empty slot belongs to this key
+            match &= (empty & (0u - empty)) - 1;
+        }
+        while (match != 0) {
+            size_t index = (pos + countTrailingZeros(match)) & mask;
+            if (keysEqual(map, key, slotAt(map, index))) {
+                return index;
+            }
+            match &= match - 1;
+        }
+        if (empty != 0) {
+            return NOT_FOUND;
+        }
+        pos = (pos + GROUP_WIDTH) & mask;
+    }
+}
+
+static size_t findEmpty(gHashMap *map, uint64_t hash) {
+    size_t mask = map->capacity - 1;
+    size_t pos = h1(hash) & mask;
+    for (;;) {
+        uint32_t empty = matchByte(map->ctrl + pos, CTRL_EMPTY);
+        if (empty != 0) {
+            return (pos + countTrailingZeros(empty)) & mask;
+        }
+        pos = (pos + GROUP_WIDTH) & mask;
+    }
+}
+
+static int resize(gHashMap *map, size_t capacity) {
+    unsigned char *ctrl = malloc(capacity + GROUP_WIDTH);
+    char *slots = malloc(capacity * map->slotSize);
+    if (ctrl == NULL || slots == NULL) {
+        free(ctrl);
+        free(slots);
+        gErrorCode = G_ENOMEN;
+        return gErrorCode;
+    }
+    memset(ctrl, CTRL_EMPTY, capacity + GROUP_WIDTH);
+
+    unsigned char *oldCtrl = map->ctrl;
+    char *oldSlots = map->slots;
+    size_t oldCapacity = map->capacity;
+    map->ctrl = ctrl;
+    map->slots = slots;
+    map->capacity = capacity;
+
+    size_t i;
+    for (i = 0; i < oldCapacity; i++) {
+        if (oldCtrl[i] != CTRL_EMPTY) {
+            char *slot = oldSlots + i * map->slotSize;
+            size_t index = findEmpty(map, hashKey(map, slot));
+            setCtrl(map, index, oldCtrl[i]);
+            memcpy(slotAt(map, index), slot, map->slotSize);
+        }
+    }
+    free(oldCtrl);
+    free(oldSlots);
+    return 0;
+}
@@ -0,0 +1,224 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/heap.h>
+#include <string.h>
+
+#define ELEM(heap, i)   ((heap)->elems + (i) * (heap)->elemSize)
+
+/**
+ * Function: siftUp
+ * ----------------
+ * Move the hole at i up while its parent is larger than the element in
+ * heap->hole, then store that element there
+ */
+static void siftUp(gHeap *heap, size_t i);
+
+/**
+ * Function: siftDown
+ * ------------------
+ * Move the hole at i down while a child is smaller than the element in
+ * heap->hole, then store that element there
+ */
+static void siftDown(gHeap *heap, size_t i);
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gHeap *gHeapCreate(size_t elemSize, unsigned int arity, cmpfunc_t compare) {
+    if (elemSize == 0 || compare == NULL || (arity != 2 && arity != 4)) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    gHeap *heap = malloc(sizeof(gHeap));
+    if (heap == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    heap->elems = malloc(HEAP_DEFAULT_ELEMS * elemSize);
+    heap->hole = malloc(elemSize);
+    if (heap->elems == NULL || heap->hole == NULL) {
+        free(heap->elems);
+        free(heap->hole);
+        free(heap);
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    heap->elemSize = elemSize;
+    heap->n = 0;
+    heap->capacity = HEAP_DEFAULT_ELEMS;
+    heap->arity = arity;
+    heap->compare = compare;
+    return heap;
+}
+
+void gHeapDelete(gHeap *heap) {
+    if (heap == NULL) {
+        return;
+    }
+    free(heap->elems);
+    free(heap->hole);
+    free(heap);
+}
+
+int gHeapReserve(gHeap *heap, size_t n) {
+    if (heap == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    if (n <= heap->capacity) {
+        return 0;
+    }
+    size_t capacity = heap->capacity * 2;
+    if (capacity < n) {
+        capacity = n;
+    }
+    char *elems = realloc(heap->elems, capacity * heap->elemSize);
+    if (elems == NULL) {
+        gErrorCode = G_ENOMEN;
+        return G_ENOMEN;
+    }
+    heap->elems = elems;
+    heap->capacity = capacity;
+    return 0;
+}
+
+int gHeapPush(gHeap *heap, const void *elem) {
+    int status = gHeapReserve(heap, heap == NULL ? 0 : heap->n + 1);
+    if (status != 0) {
+        return status;
+    }
+    memcpy(heap->hole, elem, heap->elemSize);
+    siftUp(heap, heap->n++);
+    return 0;
+}
+
+int gHeapHeapify(gHeap *heap, const void *elems, size_t n) {
+    int status = gHeapReserve(heap, heap == NULL ? 0 : heap->n + n);
+    if (status != 0) {
+        return status;
+    }
+    memcpy(ELEM(heap, heap->n), elems, n * heap->elemSize);
+    heap->n += n;
+    if (heap->n < 2) {
+        return 0;
+    }
+    // Sift down every node that has children, the last parent first
+    size_t i = (heap->n - 2) / heap->arity + 1;
+    while (i-- > 0) {
+        memcpy(heap->hole, ELEM(heap, i), heap->elemSize);
+        siftDown(heap, i);
+    }
+    return 0;
+}
+
+void *gHeapTop(gHeap *heap) {
+    if (heap == NULL || heap->n == 0) {
+        return NULL;
+    }
+    return heap->elems;
+}
+
+int gHeapPop(gHeap *heap, void *out) {
+    if (heap == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    if (heap->n == 0) {
+        gErrorCode = G_ENOITM;
+        return G_ENOITM;
+    }
+    if (out != NULL) {
+        memcpy(out, heap->elems, heap->elemSize);
+    }
+    heap->n--;
+    if (heap->n > 0) {
+        // The last element fills the hole left at the top
+        memcpy(heap->hole, ELEM(heap, heap->n), heap->elemSize);
+        siftDown(heap, 0);
+    }
+    return 0;
+}
+
+int gHeapReplaceTop(gHeap *heap, const void *elem, void *out) {
+    if (heap == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    if (heap->n == 0) {
+        gErrorCode = G_ENOITM;
+        return G_ENOITM;
+    }
+    memcpy(heap->hole, elem, heap->elemSize);
+    if (out != NULL) {
+        memcpy(out, heap->elems, heap->elemSize);
+    }
+    siftDown(heap, 0);
+    return 0;
+}
+
+/*  ------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  ------------------------------- */
+
+static void siftUp(gHeap *heap, size_t i) {
+    size_t size = heap->elemSize;
+    while (i > 0) {
+        size_t parent = (i - 1) / heap->arity;
+        if (heap->compare(heap->hole, ELEM(heap, parent)) >= 0) {
+            break;
+        }
+        memcpy(ELEM(heap, i), ELEM(heap, parent), size);
+        i = parent;
+    }
+    memcpy(ELEM(heap, i), heap->hole, size);
+}
+
+static void siftDown(gHeap *heap, size_t i) {
+    size_t size = heap->elemSize, n = heap->n, arity = heap->arity;
+    for (;;) {
+        size_t first = arity * i + 1, last, best, c;
+        if (first >= n) {
+            break;
+        }
+        last = first + arity < n ? first + arity : n;
+        best = first;
+        for (c = first + 1; c < last; c++) {
+            if (heap->compare(ELEM(heap, c), ELEM(heap, best)) < 0) {
+                best = c;
+            }
+        }
+        if (heap->compare(ELEM(heap, best), heap->hole) >= 0) {
+            break;
+        }
+        memcpy(ELEM(heap, i), ELEM(heap, best), size);
+        i = best;
+    }
+    memcpy(ELEM(heap, i), heap->hole, size);
+}
@@ -0,0 +1,429 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/hyperloglog.h>
+#include "internal.h"
+#include <generic/hash.h>
+#include <math.h>
+#include <string.h>
+
+/* Initial number of entries of the sparse list */
+#define SPARSE_INITIAL  16
+/* Keys hashed together by the batch function */
+#define BATCH_SIZE      64
+
+#define SERIAL_MAGIC    "GHLL"
+#define SERIAL_VERSION  1
+#define SERIAL_HEADER   32
+#define FORMAT_SPARSE   0
+#define FORMAT_DENSE    1
+
+/**
+ * Function: addHash
+ * -----------------
+ * Update the register selected by the top precision bits of a hash with
+ * the position of the first set bit among the others
+ *
+ * @return          status code of operation
+ */
+static int addHash(gHLL *hll, uint64_t hash);
+
+/**
+ * Function: setRegister
+ * ---------------------
+ * Raise a register to at least value, in either representation
+ *
+ * @return          status code of operation
+ */
+static int setRegister(gHLL *hll, uint32_t index, unsigned int value);
+
+/**
+ * Function: compact
+ * -----------------
+ * Sort the sparse list and keep only the largest value of each register
+ */
+static void compact(gHLL *hll);
+
+/**
+ * Function: toDense
+ * -----------------
+ * Switch a sparse sketch to one byte per register
+ *
+ * @return          status code of operation
+ */
+static int toDense(gHLL *hll);
+
+static int compareEntries(const void *a, const void *b);
+static unsigned int leadingZeros(uint64_t x);
+
+/**
+ * Functions: sigma, tau
+ * ---------------------
+ * Corrections of the estimate for empty and saturated registers,
+ * from Ertl, "New cardinality estimation algorithms for HyperLogLog
+ * sketches", 2017.
+ */
+static double sigma(double x);
+static double tau(double x);
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gHLL *gHLLCreate(size_t keySize, unsigned int precision) {
+    if (keySize == 0 || precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    gHLL *hll = malloc(sizeof(gHLL));
+    if (hll == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    hll->registers = NULL;
+    hll->sparse = malloc(SPARSE_INITIAL * sizeof(uint32_t));
+    if (hll->sparse == NULL) {
+        free(hll);
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    hll->sparseSize = 0;
+    hll->sparseSorted = 0;
+    hll->sparseCapacity = SPARSE_INITIAL;
+    hll->precision = precision;
+    hll->keySize = keySize;
+    return hll;
+}
+
+void gHLLDelete(gHLL *hll) {
+    if (hll == NULL) {
+        return;
+    }
+    free(hll->registers);
+    free(hll->sparse);
+    free(hll);
+}
+
+int gHLLAdd(gHLL *hll, void *key) {
+    if (hll == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    return addHash(hll, gHashBytes(key, hll->keySize));
+}
+
+int gHLLAddBatch(gHLL *hll, void *keys, size_t n) {
+    if (hll == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    uint64_t hashes[BATCH_SIZE];
+    char *ptr = (char *) keys;
+    size_t done, i;
+    for (done = 0; done < n; done += BATCH_SIZE) {
+        size_t count = n - done < BATCH_SIZE ? n - done : BATCH_SIZE;
+        gHashBatch(ptr + done * hll->keySize, count, hll->keySize, hashes);
+        for (i = 0; i < count; i++) {
+            int status = addHash(hll, hashes[i]);
+            if (status != 0) {
+                return status;
+            }
+        }
+    }
+    return 0;
+}
+
+double gHLLCount(gHLL *hll) {
+    if (hll == NULL) {
+        gErrorCode = G_EINVLD;
+        return 0;
+    }
+    unsigned int q = 64 - hll->precision;
+    double m = (double) ((size_t) 1 << hll->precision);
+    // Histogram of register values
+    double counts[64 + 2] = {0};
+    size_t i;
+    if (hll->registers != NULL) {
+        for (i = 0; i < ((size_t) 1 << hll->precision); i++) {
+            counts[hll->registers[i]]++;
+        }
+    } else {
+        compact(hll);
+        for (i = 0; i < hll->sparseSize; i++) {
+            counts[hll->sparse[i] & 0xff]++;
+        }
+        counts[0] = m - (double) hll->sparseSize;
+    }
+    double z = m * tau(1 - counts[q + 1] / m);
+    unsigned int k;
+    for (k = q; k >= 1; k--) {
+        z = 0.5 * (z + counts[k]);
+    }
+    z += m * sigma(counts[0] / m);
+    return m * m / (2 * M_LN2 * z);
+}
+
+int gHLLMerge(gHLL *dst, gHLL *src) {
+    if (dst == NULL || src == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    if (dst->precision != src->precision || dst->keySize != src->keySize) {
+        gErrorCode = G_EINVAL;
+        return G_EINVAL;
+    }
+    size_t i;
+    if (src->registers != NULL) {
+        if (dst->registers == NULL && toDense(dst) != 0) {
+            return gErrorCode;
+        }
+        for (i = 0; i < ((size_t) 1 << src->precision); i++) {
+            if (src->registers[i] > dst->registers[i]) {
+                dst->registers[i] = src->registers[i];
+            }
+        }
+        return 0;
+    }
+    for (i = 0; i < src->sparseSize; i++) {
+        int status = setRegister(dst, src->sparse[i] >> 8, src->sparse[i] & 0xff);
+        if (status != 0) {
+            return status;
+        }
+    }
+    return 0;
+}
+
+size_t gHLLSerialize(gHLL *hll, void *buf, size_t size) {
+    size_t m = (size_t) 1 << hll->precision;
+    size_t needed;
+    if (hll->registers != NULL) {
+        needed = SERIAL_HEADER + m;
+    } else {
+        compact(hll);
+        needed = SERIAL_HEADER + hll->sparseSize * sizeof(uint32_t);
+    }
+    if (buf == NULL || size < needed) {
+        return needed;
+    }
+    unsigned char *p = (unsigned char *) buf;
+    memcpy(p, SERIAL_MAGIC, 4);
+    putU32(p + 4, SERIAL_VERSION);
+    putU32(p + 8, hll->precision);
+    putU32(p + 12, hll->registers != NULL ? FORMAT_DENSE : FORMAT_SPARSE);
+    putU64(p + 16, hll->keySize);
+    putU64(p + 24, hll->registers != NULL ? m : hll->sparseSize);
+    p += SERIAL_HEADER;
+    size_t i;
+    if (hll->registers != NULL) {
+        memcpy(p, hll->registers, m);
+    } else {
+        for (i = 0; i < hll->sparseSize; i++) {
+            putU32(p + i * sizeof(uint32_t), hll->sparse[i]);
+        }
+    }
+    return needed;
+}
+
+gHLL *gHLLDeserialize(const void *buf, size_t size) {
+    const unsigned char *p = (const unsigned char *) buf;
+    if (buf == NULL || size < SERIAL_HEADER || memcmp(p, SERIAL_MAGIC, 4) != 0
+        || getU32(p + 4) != SERIAL_VERSION) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    unsigned int precision = getU32(p + 8);
+    unsigned int format = getU32(p + 12);
+    uint64_t keySize = getU64(p + 16);
+    uint64_t entries = getU64(p + 24);
+    if (precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION || keySize == 0
+        || (format == FORMAT_DENSE && (entries != (uint64_t) 1 << precision || entries > size - SERIAL_HEADER))
+        || (format == FORMAT_SPARSE && entries > (size - SERIAL_HEADER) / sizeof(uint32_t))
+        || format > FORMAT_DENSE) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    gHLL *hll = gHLLCreate((size_t) keySize, precision);
+    if (hll == NULL) {
+        return NULL;
+    }
+    p += SERIAL_HEADER;
+    unsigned int maxValue = 64 - precision + 1;
+    size_t i;
+    for (i = 0; i < entries; i++) {
+        uint32_t index = format == FORMAT_DENSE ? (uint32_t) i : getU32(p + i * sizeof(uint32_t)) >> 8;
+        unsigned int value = format == FORMAT_DENSE ? p[i] : getU32(p + i * sizeof(uint32_t)) & 0xff;
+        if (index >> precision != 0 || value > maxValue) {
+            gHLLDelete(hll);
+            gErrorCode = G_EINVAL;
+            return NULL;
+        }
+        if (format == FORMAT_DENSE && hll->registers == NULL && toDense(hll) != 0) {
+            gHLLDelete(hll);
+            return NULL;
+        }
+        if (value != 0 && setRegister(hll, index, value) != 0) {
+            gHLLDelete(hll);
+            return NULL;
+        }
+    }
+    return hll;
+}
+
+/*  --------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  --------------------------------- */
+
+static int addHash(gHLL *hll, uint64_t hash) {
+    unsigned int q = 64 - hll->precision;
+    uint32_t index = (uint32_t) (hash >> q);
+    uint64_t rest = hash << hll->precision;
+    // Position of the first set bit of the q remaining bits, q + 1 if none
+    unsigned int value = rest == 0 ? q + 1 : leadingZeros(rest) + 1;
+    return setRegister(hll, index, value);
+}
+
+static int setRegister(gHLL *hll, uint32_t index, unsigned int value) {
+    if (hll->registers != NULL) {
+        if (value > hll->registers[index]) {
+            hll->registers[index] = (unsigned char) value;
+        }
+        return 0;
+    }
+    if (hll->sparseSize == hll->sparseCapacity) {
+        compact(hll);
+        if (hll->sparseSize > hll->sparseCapacity / 2) {
+            // Past a quarter of the dense size the sparse list stops saving memory
+            size_t capacity = hll->sparseCapacity * 2;
+            if (capacity * sizeof(uint32_t) > ((size_t) 1 << hll->precision)) {
+                if (toDense(hll) != 0) {
+                    return gErrorCode;
+                }
+                return setRegister(hll, index, value);
+            }
+            uint32_t *sparse = realloc(hll->sparse, capacity * sizeof(uint32_t));
+            if (sparse == NULL) {
+                gErrorCode = G_ENOMEN;
+                return G_ENOMEN;
+            }
+            hll->sparse = sparse;
+            hll->sparseCapacity = capacity;
+        }
+    }
+    hll->sparse[hll->sparseSize++] = index << 8 | value;
+    return 0;
+}
+
+static void compact(gHLL *hll) {
+    if (hll->sparseSorted == hll->sparseSize) {
+        return;
+    }
+    // Entries order by index then value, the last one of an index is kept
+    qsort(hll->sparse, hll->sparseSize, sizeof(uint32_t), compareEntries);
+    size_t i, n = 0;
+    for (i = 0; i < hll->sparseSize; i++) {
+        if (n > 0 && hll->sparse[n - 1] >> 8 == hll->sparse[i] >> 8) {
+            n--;
+        }
+        hll->sparse[n++] = hll->sparse[i];
+    }
+    hll->sparseSize = n;
+    hll->sparseSorted = n;
+}
+
+static int toDense(gHLL *hll) {
+    hll->registers = calloc((size_t) 1 << hll->precision, 1);
+    if (hll->registers == NULL) {
+        gErrorCode = G_ENOMEN;
+        return G_ENOMEN;
+    }
+    size_t i;
+    for (i = 0; i < hll->sparseSize; i++) {
+        uint32_t index = hll->sparse[i] >> 8;
+        unsigned char value = (unsigned char) (hll->sparse[i] & 0xff);
+        if (value > hll->registers[index]) {
+            hll->registers[index] = value;
+        }
+    }
+    free(hll->sparse);
+    hll->sparse = NULL;
+    hll->sparseSize = 0;
+    hll->sparseSorted = 0;
+    hll->sparseCapacity = 0;
+    return 0;
+}
+
+static int compareEntries(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+static unsigned int leadingZeros(uint64_t x) {
+#if defined(__GNUC__)
+    return (unsigned int) __builtin_clzll(x);
+#else
+    unsigned int n = 0;
+    while ((x & ((uint64_t) 1 << 63)) == 0) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static double sigma(double x) {
+    if (x == 1) {
+        return INFINITY;
+    }
+    double y = 1;
+    double z = x;
+    double previous;
+    do {
+        x *= x;
+        previous = z;
+        z += x * y;
+        y += y;
+    } while (z != previous);
+    return z;
+}
+
+static double tau(double x) {
+    if (x == 0 || x == 1) {
+        return 0;
+    }
+    double y = 1;
+    double z = 1 - x;
+    double previous;
+    do {
+        x = sqrt(x);
+        previous = z;
+        y *= 0.5;
+        z -= (1 - x) * (1 - x) * y;
+    } while (z != previous);
+    return z / 3;
+}
@@ -0,0 +1,317 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/indexedheap.h>
+#include <string.h>
+
+#define ELEM(heap, i)   ((heap)->elems + (i) * (heap)->elemSize)
+
+/**
+ * Function: grow
+ * --------------
+ * Double the room for elements and handles
+ *
+ * @return          (0) if success, G_ENOMEN on allocation failure.
+ */
+static int grow(gIndexedHeap *heap);
+
+/**
+ * Function: place
+ * ---------------
+ * Store the element in heap->hole at position i under a handle
+ */
+static void place(gIndexedHeap *heap, size_t i, size_t handle);
+
+/**
+ * Function: siftUp
+ * ----------------
+ * Move the hole at i up while its parent is larger than the element in
+ * heap->hole, then place that element there
+ */
+static void siftUp(gIndexedHeap *heap, size_t i, size_t handle);
+
+/**
+ * Function: siftDown
+ * ------------------
+ * Move the hole at i down while a child is smaller than the element in
+ * heap->hole, then place that element there
+ */
+static void siftDown(gIndexedHeap *heap, size_t i, size_t handle);
+
+/**
+ * Function: resettle
+ * ------------------
+ * Place the element in heap->hole at position i, sifting it whichever
+ * way it has to go
+ */
+static void resettle(gIndexedHeap *heap, size_t i, size_t handle);
+
+/**
+ * Function: removeAt
+ * ------------------
+ * Remove the element at position i and free its handle
+ */
+static void removeAt(gIndexedHeap *heap, size_t i, void *out);
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gIndexedHeap *gIndexedHeapCreate(size_t elemSize, cmpfunc_t compare) {
+    if (elemSize == 0 || compare == NULL) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    gIndexedHeap *heap = calloc(1, sizeof(gIndexedHeap));
+    if (heap == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    heap->elemSize = elemSize;
+    heap->compare = compare;
+    heap->hole = malloc(elemSize);
+    if (heap->hole == NULL || grow(heap) != 0) {
+        gIndexedHeapDelete(heap);
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    return heap;
+}
+
+void gIndexedHeapDelete(gIndexedHeap *heap) {
+    if (heap == NULL) {
+        return;
+    }
+    free(heap->elems);
+    free(heap->handles);
+    free(heap->positions);
+    free(heap->freeHandles);
+    free(heap->hole);
+    free(heap);
+}
+
+int gIndexedHeapPush(gIndexedHeap *heap, const void *elem, size_t *handle) {
+    if (heap == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    // Every handle is in use when the heap is full
+    if (heap->n == heap->capacity && grow(heap) != 0) {
+        gErrorCode = G_ENOMEN;
+        return G_ENOMEN;
+    }
+    size_t h = heap->freeCount > 0 ? heap->freeHandles[--heap->freeCount] : heap->n;
+    memcpy(heap->hole, elem, heap->elemSize);
+    siftUp(heap, heap->n++, h);
+    if (handle != NULL) {
+        *handle = h;
+    }
+    return 0;
+}
+
+void *gIndexedHeapTop(gIndexedHeap *heap, size_t *handle) {
+    if (heap == NULL || heap->n == 0) {
+        return NULL;
+    }
+    if (handle != NULL) {
+        *handle = heap->handles[0];
+    }
+    return heap->elems;
+}
+
+int gIndexedHeapPop(gIndexedHeap *heap, void *out, size_t *handle) {
+    if (heap == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    if (heap->n == 0) {
+        gErrorCode = G_ENOITM;
+        return G_ENOITM;
+    }
+    if (handle != NULL) {
+        *handle = heap->handles[0];
+    }
+    removeAt(heap, 0, out);
+    return 0;
+}
+
+void *gIndexedHeapGet(gIndexedHeap *heap, size_t handle) {
+    if (heap == NULL || handle >= heap->capacity || heap->positions[handle] == INDEXED_HEAP_NONE) {
+        return NULL;
+    }
+    return ELEM(heap, heap->positions[handle]);
+}
+
+int gIndexedHeapDecreaseKey(gIndexedHeap *heap, size_t handle, const void *elem) {
+    void *old = gIndexedHeapGet(heap, handle);
+    if (old == NULL) {
+        gErrorCode = G_ENOITM;
+        return G_ENOITM;
+    }
+    if (heap->compare((void *) elem, old) > 0) {
+        gErrorCode = G_EINVAL;
+        return G_EINVAL;
+    }
+    memcpy(heap->hole, elem, heap->elemSize);
+    siftUp(heap, heap->positions[handle], handle);
+    return 0;
+}
+
+int gIndexedHeapIncreaseKey(gIndexedHeap *heap, size_t handle, const void *elem) {
+    void *old = gIndexedHeapGet(heap, handle);
+    if (old == NULL) {
+        gErrorCode = G_ENOITM;
+        return G_ENOITM;
+    }
+    if (heap->compare((void *) elem, old) < 0) {
+        gErrorCode = G_EINVAL;
+        return G_EINVAL;
+    }
+    memcpy(heap->hole, elem, heap->elemSize);
+    siftDown(heap, heap->positions[handle], handle);
+    return 0;
+}
+
+int gIndexedHeapUpdate(gIndexedHeap *heap, size_t handle, const void *elem) {
+    if (gIndexedHeapGet(heap, handle) == NULL) {
+        gErrorCode = G_ENOITM;
+        return G_ENOITM;
+    }
+    memcpy(heap->hole, elem, heap->elemSize);
+    resettle(heap, heap->positions[handle], handle);
+    return 0;
+}
+
+int gIndexedHeapRemove(gIndexedHeap *heap, size_t handle, void *out) {
+    if (gIndexedHeapGet(heap, handle) == NULL) {
+        gErrorCode = G_ENOITM;
+        return G_ENOITM;
+    }
+    removeAt(heap, heap->positions[handle], out);
+    return 0;
+}
+
+/*  ------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  ------------------------------- */
+
+static int grow(gIndexedHeap *heap) {
+    size_t capacity = heap->capacity ? heap->capacity * 2 : 16, i;
+    char *elems = realloc(heap->elems, capacity * heap->elemSize);
+    if (elems == NULL) {
+        return G_ENOMEN;
+    }
+    heap->elems = elems;
+    size_t *handles = realloc(heap->handles, capacity * sizeof(size_t));
+    if (handles == NULL) {
+        return G_ENOMEN;
+    }
+    heap->handles = handles;
+    size_t *positions = realloc(heap->positions, capacity * sizeof(size_t));
+    if (positions == NULL) {
+        return G_ENOMEN;
+    }
+    heap->positions = positions;
+    size_t *freeHandles = realloc(heap->freeHandles, capacity * sizeof(size_t));
+    if (freeHandles == NULL) {
+        return G_ENOMEN;
+    }
+    heap->freeHandles = freeHandles;
+    for (i = heap->capacity; i < capacity; i++) {
+        heap->positions[i] = INDEXED_HEAP_NONE;
+    }
+    heap->capacity = capacity;
+    return 0;
+}
+
+static void place(gIndexedHeap *heap, size_t i, size_t handle) {
+    memcpy(ELEM(heap, i), heap->hole, heap->elemSize);
+    heap->handles[i] = handle;
+    heap->positions[handle] = i;
+}
+
+static void siftUp(gIndexedHeap *heap, size_t i, size_t handle) {
+    while (i > 0) {
+        size_t parent = (i - 1) / INDEXED_HEAP_ARITY;
+        if (heap->compare(heap->hole, ELEM(heap, parent)) >= 0) {
+            break;
+        }
+        memcpy(ELEM(heap, i), ELEM(heap, parent), heap->elemSize);
+        heap->handles[i] = heap->handles[parent];
+        heap->positions[heap->handles[i]] = i;
+        i = parent;
+    }
+    place(heap, i, handle);
+}
+
+static void siftDown(gIndexedHeap *heap, size_t i, size_t handle) {
+    size_t n = heap->n;
+    for (;;) {
+        size_t first = INDEXED_HEAP_ARITY * i + 1, last, best, c;
+        if (first >= n) {
+            break;
+        }
+        last = first + INDEXED_HEAP_ARITY < n ? first + INDEXED_HEAP_ARITY : n;
+        best = first;
+        for (c = first + 1; c < last; c++) {
+            if (heap->compare(ELEM(heap, c), ELEM(heap, best)) < 0) {
+                best = c;
+            }
+        }
+        if (heap->compare(ELEM(heap, best), heap->hole) >= 0) {
+            break;
+        }
+        memcpy(ELEM(heap, i), ELEM(heap, best), heap->elemSize);
+        heap->handles[i] = heap->handles[best];
+        heap->positions[heap->handles[i]] = i;
+        i = best;
+    }
+    place(heap, i, handle);
+}
+
+static void resettle(gIndexedHeap *heap, size_t i, size_t handle) {
+    if (i > 0 && heap->compare(heap->hole, ELEM(heap, (i - 1) / INDEXED_HEAP_ARITY)) < 0) {
+        siftUp(heap, i, handle);
+    } else {
+        siftDown(heap, i, handle);
+    }
+}
+
+static void removeAt(gIndexedHeap *heap, size_t i, void *out) {
+    size_t handle = heap->handles[i], last = --heap->n;
+    if (out != NULL) {
+        memcpy(out, ELEM(heap, i), heap->elemSize);
+    }
+    heap->positions[handle] = INDEXED_HEAP_NONE;
+    heap->freeHandles[heap->freeCount++] = handle;
+    if (i != last) {
+        // The last element fills the hole
+        memcpy(heap->hole, ELEM(heap, last), heap->elemSize);
+        resettle(heap, i, heap->handles[last]);
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+/**
+ * @file	internal.h
+ *
+ * @brief	Helpers shared by the containers, not part of the API.
+ */
+
+#ifndef LIBGENERIC_INTERNAL_H
+#define LIBGENERIC_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Function: alignOf
+ * -----------------
+ * Alignment an object of this size may need, up to 8
+ */
+static inline size_t alignOf(size_t size) {
+    size_t align = 1;
+    while (align < 8 && (size & align) == 0) {
+        align <<= 1;
+    }
+    return align;
+}
+
+/**
+ * Function: roundUp
+ * -----------------
+ * Round size up to a multiple of align, a power of 2
+ */
+static inline size_t roundUp(size_t size, size_t align) {
+    return (size + align - 1) & ~(align - 1);
+}
+
+/*
+ * Serialized filters and sketches are little endian whatever the host,
+ * these read and write their integers a byte at a time.
+ */
+
+static inline void putU32(unsigned char *p, uint32_t v) {
+    int i;
+    for (i = 0; i < 4; i++) {
+        p[i] = (unsigned char) (v >> (8 * i));
+    }
+}
+
+static inline void putU64(unsigned char *p, uint64_t v) {
+    int i;
+    for (i = 0; i < 8; i++) {
+        p[i] = (unsigned char) (v >> (8 * i));
+    }
+}
+
+static inline uint32_t getU32(const unsigned char *p) {
+    uint32_t v = 0;
+    int i;
+    for (i = 3; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static inline uint64_t getU64(const unsigned char *p) {
+    uint64_t v = 0;
+    int i;
+    for (i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+#endif //LIBGENERIC_INTERNAL_H
@@ -0,0 +1,335 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/itree.h>
+#include <string.h>
+
+/*
+ * State shared by the recursive overlap query.
+ */
+typedef struct {
+    cmpfunc_t compare;
+    void *lo;
+    void *hi;
+    gIntervalVisit visit;
+    void *ctx;
+    size_t found;
+    int stopped;
+} query_t;
+
+/**
+ * Function: createNode
+ * --------------------
+ * Allocates and initializes an interval tree node. The node, both endpoints
+ * and the data share a single allocation.
+ *
+ * @param tree          The tree the node will belong to
+ * @param lo            Lower endpoint
+ * @param hi            Upper endpoint
+ * @param item          The data item to be stored in the node
+ *
+ * @return              The created node.
+ *                      Will return NULL in case of failure
+ */
+static ivl_node_t *createNode(gIntervalTree *tree, void *lo, void *hi, void *item);
+
+/**
+ * Function: insertNode
+ * --------------------
+ * Recursively insert a node ordered by its lower endpoint, rebalancing
+ * every subtree on the way back up.
+ *
+ * @param tree          The interval tree
+ * @param root          Root of the subtree the node is inserted into
+ * @param node          Node to be added
+ *
+ * @return              New root of the subtree
+ */
+static ivl_node_t *insertNode(gIntervalTree *tree, ivl_node_t *root, ivl_node_t *node);
+
+/**
+ * Function: update
+ * ----------------
+ * Recompute the height and the max endpoint of a node from its children.
+ *
+ * @param compare       Endpoint comparator
+ * @param node          Node to be updated
+ */
+static void update(cmpfunc_t compare, ivl_node_t *node);
+
+/**
+ * Function: leftRotate
+ * --------------------
+ * Left rotation keeping the augmentation of both nodes up to date
+ *
+ * @param compare       Endpoint comparator
+ * @param x             Node which acts as pivot to the rotation
+ *
+ * @return              New root of the subtree
+ */
+static ivl_node_t *leftRotate(cmpfunc_t compare, ivl_node_t *x);
+
+/**
+ * Function: rightRotate
+ * ---------------------
+ * Right rotation keeping the augmentation of both nodes up to date
+ *
+ * @param compare       Endpoint comparator
+ * @param x             Node which acts as pivot to the rotation
+ *
+ * @return              New root of the subtree
+ */
+static ivl_node_t *rightRotate(cmpfunc_t compare, ivl_node_t *x);
+
+/**
+ * Function: rebalance
+ * -------------------
+ * Restore the AVL property of a subtree whose children are balanced but
+ * whose heights may differ by two. Same four cases as in avl.c.
+ *
+ * @param compare       Endpoint comparator
+ * @param node          Root of the subtree
+ *
+ * @return              New root of the subtree
+ */
+static ivl_node_t *rebalance(cmpfunc_t compare, ivl_node_t *node);
+
+/**
+ * Function: queryRange
+ * --------------------
+ * Report the intervals of a subtree overlapping [q->lo, q->hi] in order
+ * of their lower endpoint.
+ *
+ * @param q             Query state
+ * @param node          Root of the subtree being searched
+ */
+static void queryRange(query_t *q, ivl_node_t *node);
+
+/**
+ * Function: clearTree
+ * -------------------
+ * This function will recursively clear ( free ) a tree.
+ *
+ * @param node      Root node of tree to be cleared.
+ */
+static void clearTree(ivl_node_t *node);
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gIntervalTree *gIntervalTreeCreate(size_t keySize, size_t elementSize, cmpfunc_t compare) {
+    if (keySize == 0 || compare == NULL) {
+        gErrorCode = G_EINVAL;
+        return NULL;
+    }
+    gIntervalTree *tree = malloc(sizeof(gIntervalTree));
+    if (tree == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    tree->root = NULL;
+    tree->compare = compare;
+    tree->keySize = keySize;
+    tree->elementSize = elementSize;
+    tree->size = 0;
+    return tree;
+}
+
+int gIntervalTreeAdd(gIntervalTree *tree, void *lo, void *hi, void *item) {
+    if (tree == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    if (tree->compare(lo, hi) > 0) {
+        gErrorCode = G_EINVAL;
+        return gErrorCode;
+    }
+    ivl_node_t *node = createNode(tree, lo, hi, item);
+    if (node == NULL) {
+        return gErrorCode;
+    }
+    tree->root = insertNode(tree, tree->root, node);
+    tree->size++;
+    return 0;
+}
+
+void gIntervalTreeDelete(gIntervalTree *tree) {
+    if (tree == NULL) {
+        return;
+    }
+    if (tree->root != NULL) {
+        clearTree(tree->root);
+    }
+    free(tree);
+}
+
+size_t gIntervalOverlaps(gIntervalTree *tree, void *point, gIntervalVisit visit, void *ctx) {
+    return gIntervalOverlapsRange(tree, point, point, visit, ctx);
+}
+
+size_t gIntervalOverlapsRange(gIntervalTree *tree, void *lo, void *hi, gIntervalVisit visit, void *ctx) {
+    if (tree == NULL) {
+        gErrorCode = G_EINVLD;
+        return 0;
+    }
+    query_t q;
+    q.compare = tree->compare;
+    q.lo = lo;
+    q.hi = hi;
+    q.visit = visit;
+    q.ctx = ctx;
+    q.found = 0;
+    q.stopped = 0;
+    queryRange(&q, tree->root);
+    return q.found;
+}
+
+/*  --------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  --------------------------------- */
+
+static ivl_node_t *createNode(gIntervalTree *tree, void *lo, void *hi, void *item) {
+    ivl_node_t *node = malloc(sizeof(ivl_node_t) + 2 * tree->keySize + tree->elementSize);
+    if (node == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    char *payload = (char *) (node + 1);
+    node->lo = payload;
+    node->hi = payload + tree->keySize;
+    node->data = tree->elementSize > 0 ? payload + 2 * tree->keySize : NULL;
+    memcpy(node->lo, lo, tree->keySize);
+    memcpy(node->hi, hi, tree->keySize);
+    if (node->data != NULL) {
+        memcpy(node->data, item, tree->elementSize);
+    }
+    node->max = node->hi;
+    node->left = NULL;
+    node->right = NULL;
+    node->height = 1;
+    return node;
+}
+
+static ivl_node_t *insertNode(gIntervalTree *tree, ivl_node_t *root, ivl_node_t *node) {
+    if (root == NULL) {
+        return node;
+    }
+    if (tree->compare(node->lo, root->lo) < 0) {
+        root->left = insertNode(tree, root->left, node);
+    }
+    else {
+        root->right = insertNode(tree, root->right, node);
+    }
+    return rebalance(tree->compare, root);
+}
+
+static int height(ivl_node_t *node) {
+    return node == NULL ? 0 : node->height;
+}
+
+static void update(cmpfunc_t compare, ivl_node_t *node) {
+    int lh = height(node->left);
+    int rh = height(node->right);
+    node->height = 1 + (lh > rh ? lh : rh);
+    node->max = node->hi;
+    if (node->left != NULL && compare((void *) node->left->max, (void *) node->max) > 0) {
+        node->max = node->left->max;
+    }
+    if (node->right != NULL && compare((void *) node->right->max, (void *) node->max) > 0) {
+        node->max = node->right->max;
+    }
+}
+
+static ivl_node_t *leftRotate(cmpfunc_t compare, ivl_node_t *x) {
+    ivl_node_t *y = x->right;
+    x->right = y->left;
+    y->left = x;
+    update(compare, x);
+    update(compare, y);
+    return y;
+}
+
+static ivl_node_t *rightRotate(cmpfunc_t compare, ivl_node_t *x) {
+    ivl_node_t *y = x->left;
+    x->left = y->right;
+    y->right = x;
+    update(compare, x);
+    update(compare, y);
+    return y;
+}
+
+static ivl_node_t *rebalance(cmpfunc_t compare, ivl_node_t *node) {
+    int balance = height(node->left) - height(node->right);
+    if (balance > 1) {
+        if (height(node->left->left) < height(node->left->right)) {
+            node->left = leftRotate(compare, node->left);
+        }
+        return rightRotate(compare, node);
+    }
+    if (balance < -1) {
+        if (height(node->right->right) < height(node->right->left)) {
+            node->right = rightRotate(compare, node->right);
+        }
+        return leftRotate(compare, node);
+    }
+    update(compare, node);
+    return node;
+}
+
+static void queryRange(query_t *q, ivl_node_t *node) {
+    while (node != NULL && !q->stopped) {
+        // Nothing in this subtree reaches the range
+        if (q->compare((void *) node->max, q->lo) < 0) {
+            return;
+        }
+        queryRange(q, node->left);
+        if (q->stopped) {
+            return;
+        }
+        // This node and its right subtree start after the range
+        if (q->compare(node->lo, q->hi) > 0) {
+            return;
+        }
+        if (q->compare(node->hi, q->lo) >= 0) {
+            q->found++;
+            if (q->visit != NULL && q->visit(node, q->ctx)) {
+                q->stopped = 1;
+            }
+        }
+        node = node->right;
+    }
+}
+
+static void clearTree(ivl_node_t *node) {
+    if (node->left != NULL)
+        clearTree(node->left);
+    if (node->right != NULL)
+        clearTree(node->right);
+    free(node);
+}
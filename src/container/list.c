@@ -22,6 +22,9 @@
  *   SOFTWARE.
  */
 
+// The accessors are compiled here from the header, out of line
+#undef GENERIC_INLINE
+#define LIST_ACCESSORS_IMPL
 #include <generic/list.h>
 
 
@@ -225,10 +228,38 @@ int gListIterate(gListIterator iter) {
     return 0;
 }
 
-void *gListGetIteratorData(gListIterator iter) {
-    if (*iter == NULL) {
-        gErrorCode = G_EITMEND;
-        return NULL;
+void gDListInit(dnode *head) {
+    head->prev = head;
+    head->next = head;
+}
+
+int gDListIsEmpty(dnode *head) {
+    return head->next == head;
+}
+
+void gDListPushFront(dnode *head, dnode *item) {
+    item->prev = head;
+    item->next = head->next;
+    head->next->prev = item;
+    head->next = item;
+}
+
+void gDListPushBack(dnode *head, dnode *item) {
+    gDListPushFront(head->prev, item);
+}
+
+void gDListRemove(dnode *item) {
+    item->prev->next = item->next;
+    item->next->prev = item->prev;
+    item->prev = item;
+    item->next = item;
+}
+
+void gDListMoveFront(dnode *head, dnode *item) {
+    if (head->next == item) {
+        return;
     }
-    return (*iter)->data;
-}
\ No newline at end of file
+    item->prev->next = item->next;
+    item->next->prev = item->prev;
+    gDListPushFront(head, item);
+}
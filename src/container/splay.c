@@ -0,0 +1,217 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/splay.h>
+#include <string.h>
+
+/**
+ * Function: createNode
+ * --------------------
+ * Allocates and initializes a node, the data is stored in the same
+ * allocation right after the node.
+ *
+ * @param item           The data item to be stored in the node
+ * @param itemSize       The size of data item
+ *
+ * @return               The created node.
+ *                       Will return NULL in case of failure
+ */
+static bnode_t *createNode(void *item, size_t itemSize);
+
+/**
+ * Function: splay
+ * ---------------
+ * Top-down splay. Walks down from the root looking for data, rotating on
+ * zig-zig steps and hanging the passed subtrees on a left and a right tree,
+ * which are reassembled around the last visited node at the end.
+ *
+ * @param root          Root of the tree
+ * @param data          The item being looked for
+ * @param isGreater     The function that will compare the values of nodes
+ *
+ * @return              New root of the tree, the node containing data or
+ *                      the last node on its search path.
+ */
+static bnode_t *splay(bnode_t *root, void *data, gDataCompare isGreater);
+
+/**
+ * Function: clearTree
+ * -------------------
+ * Free every node of a tree. Splay trees may degenerate into long paths,
+ * so the tree is flattened with rotations instead of using recursion.
+ *
+ * @param node      Root node of tree to be cleared.
+ */
+static void clearTree(bnode_t *node);
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+gSplay *gSplayCreate(size_t elementSize, gDataCompare comparator) {
+    gSplay *tree = malloc(sizeof(gSplay));
+    if (tree == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    tree->root = NULL;
+    tree->elementSize = elementSize;
+    tree->isGreater = comparator;
+    tree->size = 0;
+    return tree;
+}
+
+int gSplayAdd(gSplay *tree, void *item) {
+    if (tree == NULL) {
+        gErrorCode = G_EINVLD;
+        return gErrorCode;
+    }
+    bnode_t *node = createNode(item, tree->elementSize);
+    if (node == NULL) {
+        return gErrorCode;
+    }
+    if (tree->root != NULL) {
+        bnode_t *root = splay(tree->root, node->data, tree->isGreater);
+        if (tree->isGreater(root->data, node->data)) {
+            node->left = root->left;
+            node->right = root;
+            root->left = NULL;
+        }
+        else {
+            node->right = root->right;
+            node->left = root;
+            root->right = NULL;
+        }
+    }
+    tree->root = node;
+    tree->size++;
+    return 0;
+}
+
+void gSplayDelete(gSplay *tree) {
+    if (tree == NULL) {
+        return;
+    }
+    clearTree(tree->root);
+    free(tree);
+}
+
+bnode_t *gSplaySearch(gSplay *tree, void *data) {
+    if (tree == NULL) {
+        gErrorCode = G_ENOITM;
+        return NULL;
+    }
+    if (tree->root == NULL) {
+        return NULL;
+    }
+    tree->root = splay(tree->root, data, tree->isGreater);
+    if (tree->isGreater(tree->root->data, data) || tree->isGreater(data, tree->root->data)) {
+        return NULL;
+    }
+    return tree->root;
+}
+
+/*  --------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  --------------------------------- */
+
+static bnode_t *createNode(void *item, size_t itemSize) {
+    bnode_t *node = malloc(sizeof(bnode_t) + itemSize);
+    if (node == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    node->left = NULL;
+    node->right = NULL;
+    node->data = node + 1;
+    memcpy(node->data, item, itemSize);
+    return node;
+}
+
+static bnode_t *splay(bnode_t *root, void *data, gDataCompare isGreater) {
+    bnode_t header;
+    bnode_t *left = &header, *right = &header, *tmp;
+    header.left = header.right = NULL;
+    for (;;) {
+        if (isGreater(root->data, data)) {
+            if (root->left == NULL)
+                break;
+            if (isGreater(root->left->data, data)) {    // Zig-zig, rotate right
+                tmp = root->left;
+                root->left = tmp->right;
+                tmp->right = root;
+                root = tmp;
+                if (root->left == NULL)
+                    break;
+            }
+            right->left = root;                         // Link right
+            right = root;
+            root = root->left;
+        }
+        else if (isGreater(data, root->data)) {
+            if (root->right == NULL)
+                break;
+            if (isGreater(data, root->right->data)) {   // Zig-zig, rotate left
+                tmp = root->right;
+                root->right = tmp->left;
+                tmp->left = root;
+                root = tmp;
+                if (root->right == NULL)
+                    break;
+            }
+            left->right = root;                         // Link left
+            left = root;
+            root = root->right;
+        }
+        else {
+            break;
+        }
+    }
+    // Reassemble
+    left->right = root->left;
+    right->left = root->right;
+    root->left = header.right;
+    root->right = header.left;
+    return root;
+}
+
+static void clearTree(bnode_t *node) {
+    while (node != NULL) {
+        if (node->left != NULL) {
+            bnode_t *left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        }
+        else {
+            bnode_t *next = node->right;
+            free(node);
+            node = next;
+        }
+    }
+}
@@ -0,0 +1,211 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/timerwheel.h>
+
+#define SLOT_MASK   (TIMER_WHEEL_SLOTS - 1)
+
+/** @brief Ticks spanned by all the levels */
+#define WHEEL_SPAN  ((uint64_t) 1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))
+
+/**
+ * Function: slotOf
+ * ----------------
+ * Find the slot a timer expiring at a tick belongs to
+ */
+static dnode *slotOf(gTimerWheel *wheel, uint64_t expires);
+
+/**
+ * Function: splice
+ * ----------------
+ * Move all the timers of a slot to an uninitialized list head, O(1)
+ */
+static void splice(dnode *slot, dnode *head);
+
+/**
+ * Function: cascade
+ * -----------------
+ * Place again the timers of the current slot of a level, they all go
+ * to finer levels
+ *
+ * @return          The index of the slot
+ */
+static unsigned int cascade(gTimerWheel *wheel, unsigned int level);
+
+/*  ------------------------------- *
+ *
+ *  The API implementations follow.
+ *
+ *  ------------------------------- */
+
+void gTimerInit(gTimer *timer) {
+    gDListInit(&timer->link);
+    timer->expires = 0;
+}
+
+int gTimerPending(const gTimer *timer) {
+    return timer->link.next != &timer->link;
+}
+
+gTimerWheel *gTimerWheelCreate(uint64_t now) {
+    gTimerWheel *wheel = malloc(sizeof(gTimerWheel));
+    unsigned int level, i;
+    if (wheel == NULL) {
+        gErrorCode = G_ENOMEN;
+        return NULL;
+    }
+    for (level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+            gDListInit(&wheel->slots[level][i]);
+        }
+    }
+    wheel->tick = now;
+    wheel->n = 0;
+    return wheel;
+}
+
+void gTimerWheelDelete(gTimerWheel *wheel) {
+    unsigned int level, i;
+    if (wheel == NULL) {
+        return;
+    }
+    for (level = 0; level < TIMER_WHEEL_LEVELS && wheel->n > 0; level++) {
+        for (i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+            dnode *slot = &wheel->slots[level][i];
+            while (!gDListIsEmpty(slot)) {
+                gDListRemove(slot->next);
+                wheel->n--;
+            }
+        }
+    }
+    free(wheel);
+}
+
+int gTimerWheelSchedule(gTimerWheel *wheel, gTimer *timer, uint64_t expires) {
+    if (wheel == NULL || timer == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    if (gTimerPending(timer)) {
+        gDListRemove(&timer->link);
+    } else {
+        wheel->n++;
+    }
+    timer->expires = expires;
+    gDListPushBack(slotOf(wheel, expires), &timer->link);
+    return 0;
+}
+
+int gTimerWheelCancel(gTimerWheel *wheel, gTimer *timer) {
+    if (wheel == NULL || timer == NULL) {
+        gErrorCode = G_EINVLD;
+        return G_EINVLD;
+    }
+    if (!gTimerPending(timer)) {
+        gErrorCode = G_ENOITM;
+        return G_ENOITM;
+    }
+    gDListRemove(&timer->link);
+    wheel->n--;
+    return 0;
+}
+
+size_t gTimerWheelAdvance(gTimerWheel *wheel, uint64_t now, gTimerFunc expire, void *arg) {
+    size_t fired = 0;
+    dnode expired;
+    if (wheel == NULL || expire == NULL) {
+        gErrorCode = G_EINVLD;
+        return 0;
+    }
+    while (wheel->tick <= now) {
+        if (wheel->n == 0) {
+            // Nothing to cascade or fire, skip the idle ticks at once
+            wheel->tick = now + 1;
+            break;
+        }
+        unsigned int index = wheel->tick & SLOT_MASK, level;
+        // Level k turns when the 8*k low bits of the tick wrap around
+        if (index == 0) {
+            for (level = 1; level < TIMER_WHEEL_LEVELS && cascade(wheel, level) == 0; level++);
+        }
+        splice(&wheel->slots[0][index], &expired);
+        wheel->tick++;
+        while (!gDListIsEmpty(&expired)) {
+            gTimer *timer = gDLIST_ENTRY(expired.next, gTimer, link);
+            gDListRemove(&timer->link);
+            wheel->n--;
+            fired++;
+            expire(timer, arg);
+        }
+    }
+    return fired;
+}
+
+/*  ------------------------------- *
+ *
+ *  Utility function implementations.
+ *
+ *  ------------------------------- */
+
+static dnode *slotOf(gTimerWheel *wheel, uint64_t expires) {
+    uint64_t delta;
+    unsigned int level = 0;
+    if (expires < wheel->tick) {
+        expires = wheel->tick;
+    }
+    delta = expires - wheel->tick;
+    if (delta >= WHEEL_SPAN) {
+        // Park it in the last slot within reach, it is placed again from there
+        expires = wheel->tick + WHEEL_SPAN - 1;
+        delta = WHEEL_SPAN - 1;
+    }
+    while (delta >> (TIMER_WHEEL_BITS * (level + 1))) {
+        level++;
+    }
+    return &wheel->slots[level][(expires >> (TIMER_WHEEL_BITS * level)) & SLOT_MASK];
+}
+
+static void splice(dnode *slot, dnode *head) {
+    if (gDListIsEmpty(slot)) {
+        gDListInit(head);
+        return;
+    }
+    head->next = slot->next;
+    head->prev = slot->prev;
+    head->next->prev = head;
+    head->prev->next = head;
+    gDListInit(slot);
+}
+
+static unsigned int cascade(gTimerWheel *wheel, unsigned int level) {
+    unsigned int index = (wheel->tick >> (TIMER_WHEEL_BITS * level)) & SLOT_MASK;
+    dnode timers;
+    splice(&wheel->slots[level][index], &timers);
+    while (!gDListIsEmpty(&timers)) {
+        gTimer *timer = gDLIST_ENTRY(timers.next, gTimer, link);
+        gDListRemove(&timer->link);
+        gDListPushBack(slotOf(wheel, timer->expires), &timer->link);
+    }
+    return index;
+}
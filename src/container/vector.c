@@ -22,6 +22,10 @@
  *   SOFTWARE.
  */
 
+// The accessors are compiled here from the header, out of line
+#undef GENERIC_INLINE
+#define VECTOR_ACCESSORS_IMPL
+#include <generic.h>
 #include <generic/vector.h>
 #include <assert.h>
 #include <string.h>
@@ -70,34 +74,14 @@ void *gVectorPopBack(struct gVector *vector) {
 void gVectorResize(gVector *vector, size_t new_size) {
     assert(vector != NULL);
     size_t tmp = new_size * vector->elem_sz;
+    void *elems = realloc(vector->elems, tmp);
+    if (elems == NULL && tmp > 0) {
+        gErrorCode = G_ENOMEN;
+        return;
+    }
     vector->alloc = tmp;
     vector->n = new_size;
-    vector->elems = realloc(vector->elems, tmp);
-}
-
-void *gVectorFront(gVector *vector) {
-    assert(vector != NULL);
-    return vector->elems;
-}
-
-void *gVectorBack(gVector *vector) {
-    if (vector->n == 0) {
-        return vector->elems;
-    }
-    return gVectorItemAt(vector, vector->n - 1);
-}
-
-void *gVectorItemAt(gVector *vector, size_t index) {
-    assert(vector != NULL);
-    size_t size = index * vector->elem_sz;
-    char *ptr = (char *) vector->elems;
-    return ptr + size;
-}
-
-void *gVectorSet(gVector *vector, size_t pos, void *val) {
-    void *ptr = gVectorItemAt(vector, pos);
-    memcpy(ptr, val, vector->elem_sz);
-    return ptr;
+    vector->elems = elems;
 }
 
 void *gVectorInsert(gVector *vector, size_t pos, void *val) {
@@ -0,0 +1,233 @@
+/*
+ *   MIT License
+ *
+ *   Copyright (c) 2018 Sidhin S Thomas
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in all
+ *   copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *   SOFTWARE.
+ */
+
+#include <generic/hash.h>
+#include <string.h>    // memcpy
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HASH_AVX2_DISPATCH
+#endif
+
+/* wyhash secret */
+static const uint64_t SECRET[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+/* Added before mixing so that 0 does not hash to 0 */
+#define GOLDEN  0x9e3779b97f4a7c15ull
+#define MIX_M1  0x3c79ac492ba7b653ull
+#define MIX_M2  0x1c69b3f74ac4ae35ull
+
+static uint64_t read64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t read32(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/* 64x64 -> 128 bit multiplication, low half in *a and high half in *b */
+static void multiply(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t) *a * *b;
+    *a = (uint64_t) r;
+    *b = (uint64_t) (r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static uint64_t mix(uint64_t a, uint64_t b) {
+    multiply(&a, &b);
+    return a ^ b;
+}
+
+/* Integer finalizer, a bijection on 64 bits */
+static uint64_t mix64(uint64_t x) {
+    x += GOLDEN;
+    x ^= x >> 27;
+    x *= MIX_M1;
+    x ^= x >> 33;
+    x *= MIX_M2;
+    x ^= x >> 27;
+    return x;
+}
+
+static uint64_t wyhash(const void *key, size_t len, uint64_t seed) {
+    const unsigned char *p = (const unsigned char *) key;
+    uint64_t a, b;
+    seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (read32(p) << 32) | read32(p + ((len >> 3) << 2));
+            b = (read32(p + len - 4) << 32) | read32(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = ((uint64_t) p[0] << 16) | ((uint64_t) p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = mix(read64(p) ^ SECRET[1], read64(p + 8) ^ seed);
+                see1 = mix(read64(p + 16) ^ SECRET[2], read64(p + 24) ^ see1);
+                see2 = mix(read64(p + 32) ^ SECRET[3], read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = mix(read64(p) ^ SECRET[1], read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+    a ^= SECRET[1];
+    b ^= seed;
+    multiply(&a, &b);
+    return mix(a ^ SECRET[0] ^ len, b ^ SECRET[1]);
+}
+
+uint64_t gHashU32(uint32_t key) {
+    return mix64(key);
+}
+
+uint64_t gHashU64(uint64_t key) {
+    return mix64(key);
+}
+
+uint64_t gHash128(const void *key) {
+    return wyhash(key, 16, 0);
+}
+
+uint64_t gHashBytes(const void *key, size_t len) {
+    switch (len) {
+        case 4:
+            return mix64(read32((const unsigned char *) key));
+        case 8:
+            return mix64(read64((const unsigned char *) key));
+        default:
+            return wyhash(key, len, 0);
+    }
+}
+
+uint64_t gHashBytesSeed(const void *key, size_t len, uint64_t seed) {
+    if (seed == 0) {
+        return gHashBytes(key, len);
+    }
+    return wyhash(key, len, seed);
+}
+
+#ifdef HASH_AVX2_DISPATCH
+
+/* Low 64 bits of the lane-wise product, AVX2 has no 64 bit multiply */
+__attribute__((target("avx2")))
+static __m256i multiply64x4(__m256i a, __m256i b) {
+    __m256i lo = _mm256_mul_epu32(a, b);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                     _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+__attribute__((target("avx2")))
+static __m256i mix64x4(__m256i x) {
+    x = _mm256_add_epi64(x, _mm256_set1_epi64x((long long) GOLDEN));
+    x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 27));
+    x = multiply64x4(x, _mm256_set1_epi64x((long long) MIX_M1));
+    x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 33));
+    x = multiply64x4(x, _mm256_set1_epi64x((long long) MIX_M2));
+    x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 27));
+    return x;
+}
+
+/* Hash 4 or 8 byte keys four at a time, returns the number of keys done */
+__attribute__((target("avx2")))
+static size_t batchAVX2(const unsigned char *keys, size_t n, size_t keySize, uint64_t *out) {
+    size_t i = 0;
+    if (keySize == 4) {
+        for (; i + 4 <= n; i += 4) {
+            __m128i k = _mm_loadu_si128((const __m128i *) (keys + i * 4));
+            _mm256_storeu_si256((__m256i *) (out + i), mix64x4(_mm256_cvtepu32_epi64(k)));
+        }
+    } else {
+        for (; i + 4 <= n; i += 4) {
+            __m256i k = _mm256_loadu_si256((const __m256i *) (keys + i * 8));
+            _mm256_storeu_si256((__m256i *) (out + i), mix64x4(k));
+        }
+    }
+    return i;
+}
+
+#endif
+
+void gHashBatch(const void *keys, size_t n, size_t keySize, uint64_t *out) {
+    const unsigned char *p = (const unsigned char *) keys;
+    size_t i = 0;
+    switch (keySize) {
+        case 4:
+        case 8:
+#ifdef HASH_AVX2_DISPATCH
+            if (__builtin_cpu_supports("avx2")) {
+                i = batchAVX2(p, n, keySize, out);
+            }
+#endif
+            if (keySize == 4) {
+                for (; i < n; i++) {
+                    out[i] = mix64(read32(p + i * 4));
+                }
+            } else {
+                for (; i < n; i++) {
+                    out[i] = mix64(read64(p + i * 8));
+                }
+            }
+            break;
+        case 16:
+            for (; i < n; i++) {
+                out[i] = gHash128(p + i * 16);
+            }
+            break;
+        default:
+            for (; i < n; i++) {
+                out[i] = wyhash(p + i * keySize, keySize, 0);
+            }
+            break;
+    }
+}
@@ -26,16 +26,57 @@
 #include <generic/utils.h>
 #include <string.h>    // memcpy and NULL
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define X86_SSE2
+#include <immintrin.h>
+#ifndef GENERIC_NO_AVX2
+#define X86_AVX2
+#define AVX2 __attribute__((target("avx2")))
+/* Reads a value cached by libgcc at startup, cheap enough for every call */
+#define HAVE_AVX2() __builtin_cpu_supports("avx2")
+#endif
+#endif
+
+/*
+ * Swaps 32 bytes at a time through a fixed size buffer, which the compiler
+ * turns into vector loads and stores, then the remainder by words.
+ */
+static inline void swapBytes(char *x, char *y, size_t sz) {
+    unsigned char t[32];
+    uint64_t u, v;
+    uint32_t p, q;
+    for (; sz >= 32; sz -= 32, x += 32, y += 32) {
+        memcpy(t, x, 32);
+        memcpy(x, y, 32);
+        memcpy(y, t, 32);
+    }
+    for (; sz >= 8; sz -= 8, x += 8, y += 8) {
+        memcpy(&u, x, 8);
+        memcpy(&v, y, 8);
+        memcpy(x, &v, 8);
+        memcpy(y, &u, 8);
+    }
+    if (sz >= 4) {
+        memcpy(&p, x, 4);
+        memcpy(&q, y, 4);
+        memcpy(x, &q, 4);
+        memcpy(y, &p, 4);
+        sz -= 4, x += 4, y += 4;
+    }
+    for (; sz > 0; sz--, x++, y++) {
+        char c = *x;
+        *x = *y;
+        *y = c;
+    }
+}
+
 void gSwap(void *a, void *b, size_t sz) {
-    char x[sz];
-    memcpy(x, a, sz);    // Save A
-    memcpy(a, b, sz);    // Copy B to A
-    memcpy(b, x, sz);    // Copy saved A to B
+    swapBytes((char *) a, (char *) b, sz);
 }
 
 void *gSearch(const void *key, const void *base, size_t n, size_t elem_sz, cmpfunc_t cmpfunc) {
     char *x = (char *) base;
-    int i;
+    size_t i;
     for (i = 0; i < n; i++) {
         if (!cmpfunc((void*)key, x)) {
             return x;
@@ -45,12 +86,310 @@ void *gSearch(const void *key, const void *base, size_t n, size_t elem_sz, cmpfu
     return NULL;
 }
 
+/*
+ * The typed searches compare whole vectors against the key and only look
+ * at the masks when a group of four vectors has a match.
+ */
+
+#define SCALAR_TAIL(base, i, n, key) \
+    for (; i < n; i++) { \
+        if (base[i] == key) { \
+            return base + i; \
+        } \
+    } \
+    return NULL
+
+#ifdef X86_SSE2
+static const int32_t *searchI32SSE2(const int32_t *base, size_t n, int32_t key) {
+    const __m128i k = _mm_set1_epi32(key);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i *p = (const __m128i *) (base + i);
+        __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128(p), k);
+        __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128(p + 1), k);
+        __m128i c = _mm_cmpeq_epi32(_mm_loadu_si128(p + 2), k);
+        __m128i d = _mm_cmpeq_epi32(_mm_loadu_si128(p + 3), k);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)))) {
+            unsigned mask = _mm_movemask_ps(_mm_castsi128_ps(a))
+                            | _mm_movemask_ps(_mm_castsi128_ps(b)) << 4
+                            | _mm_movemask_ps(_mm_castsi128_ps(c)) << 8
+                            | _mm_movemask_ps(_mm_castsi128_ps(d)) << 12;
+            return base + i + __builtin_ctz(mask);
+        }
+    }
+    SCALAR_TAIL(base, i, n, key);
+}
+
+/* SSE2 has no 64 bit compare: both 32 bit halves must be equal */
+static __m128i cmpeq64SSE2(__m128i x, __m128i k) {
+    __m128i eq = _mm_cmpeq_epi32(x, k);
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+static const int64_t *searchI64SSE2(const int64_t *base, size_t n, int64_t key) {
+    const __m128i k = _mm_set1_epi64x(key);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i *p = (const __m128i *) (base + i);
+        __m128i a = cmpeq64SSE2(_mm_loadu_si128(p), k);
+        __m128i b = cmpeq64SSE2(_mm_loadu_si128(p + 1), k);
+        __m128i c = cmpeq64SSE2(_mm_loadu_si128(p + 2), k);
+        __m128i d = cmpeq64SSE2(_mm_loadu_si128(p + 3), k);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)))) {
+            unsigned mask = _mm_movemask_pd(_mm_castsi128_pd(a))
+                            | _mm_movemask_pd(_mm_castsi128_pd(b)) << 2
+                            | _mm_movemask_pd(_mm_castsi128_pd(c)) << 4
+                            | _mm_movemask_pd(_mm_castsi128_pd(d)) << 6;
+            return base + i + __builtin_ctz(mask);
+        }
+    }
+    SCALAR_TAIL(base, i, n, key);
+}
+
+static const float *searchF32SSE2(const float *base, size_t n, float key) {
+    const __m128 k = _mm_set1_ps(key);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128 a = _mm_cmpeq_ps(_mm_loadu_ps(base + i), k);
+        __m128 b = _mm_cmpeq_ps(_mm_loadu_ps(base + i + 4), k);
+        __m128 c = _mm_cmpeq_ps(_mm_loadu_ps(base + i + 8), k);
+        __m128 d = _mm_cmpeq_ps(_mm_loadu_ps(base + i + 12), k);
+        if (_mm_movemask_ps(_mm_or_ps(_mm_or_ps(a, b), _mm_or_ps(c, d)))) {
+            unsigned mask = _mm_movemask_ps(a) | _mm_movemask_ps(b) << 4
+                            | _mm_movemask_ps(c) << 8 | _mm_movemask_ps(d) << 12;
+            return base + i + __builtin_ctz(mask);
+        }
+    }
+    SCALAR_TAIL(base, i, n, key);
+}
+#endif
+
+#ifdef X86_AVX2
+AVX2 static const int32_t *searchI32AVX2(const int32_t *base, size_t n, int32_t key) {
+    const __m256i k = _mm256_set1_epi32(key);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i *p = (const __m256i *) (base + i);
+        __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256(p), k);
+        __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 1), k);
+        __m256i c = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 2), k);
+        __m256i d = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 3), k);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+        if (!_mm256_testz_si256(any, any)) {
+            unsigned mask = (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(a))
+                            | (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8
+                            | (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(c)) << 16
+                            | (unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(d)) << 24;
+            return base + i + __builtin_ctz(mask);
+        }
+    }
+    SCALAR_TAIL(base, i, n, key);
+}
+
+AVX2 static const int64_t *searchI64AVX2(const int64_t *base, size_t n, int64_t key) {
+    const __m256i k = _mm256_set1_epi64x(key);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i *p = (const __m256i *) (base + i);
+        __m256i a = _mm256_cmpeq_epi64(_mm256_loadu_si256(p), k);
+        __m256i b = _mm256_cmpeq_epi64(_mm256_loadu_si256(p + 1), k);
+        __m256i c = _mm256_cmpeq_epi64(_mm256_loadu_si256(p + 2), k);
+        __m256i d = _mm256_cmpeq_epi64(_mm256_loadu_si256(p + 3), k);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+        if (!_mm256_testz_si256(any, any)) {
+            unsigned mask = (unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(a))
+                            | (unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(b)) << 4
+                            | (unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(c)) << 8
+                            | (unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(d)) << 12;
+            return base + i + __builtin_ctz(mask);
+        }
+    }
+    SCALAR_TAIL(base, i, n, key);
+}
+
+AVX2 static const float *searchF32AVX2(const float *base, size_t n, float key) {
+    const __m256 k = _mm256_set1_ps(key);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256 a = _mm256_cmp_ps(_mm256_loadu_ps(base + i), k, _CMP_EQ_OQ);
+        __m256 b = _mm256_cmp_ps(_mm256_loadu_ps(base + i + 8), k, _CMP_EQ_OQ);
+        __m256 c = _mm256_cmp_ps(_mm256_loadu_ps(base + i + 16), k, _CMP_EQ_OQ);
+        __m256 d = _mm256_cmp_ps(_mm256_loadu_ps(base + i + 24), k, _CMP_EQ_OQ);
+        if (_mm256_movemask_ps(_mm256_or_ps(_mm256_or_ps(a, b), _mm256_or_ps(c, d)))) {
+            unsigned mask = (unsigned) _mm256_movemask_ps(a) | (unsigned) _mm256_movemask_ps(b) << 8
+                            | (unsigned) _mm256_movemask_ps(c) << 16 | (unsigned) _mm256_movemask_ps(d) << 24;
+            return base + i + __builtin_ctz(mask);
+        }
+    }
+    SCALAR_TAIL(base, i, n, key);
+}
+#endif
+
+const int32_t *gSearchI32(const int32_t *base, size_t n, int32_t key) {
+#ifdef X86_AVX2
+    if (HAVE_AVX2()) {
+        return searchI32AVX2(base, n, key);
+    }
+#endif
+#ifdef X86_SSE2
+    return searchI32SSE2(base, n, key);
+#else
+    size_t i = 0;
+    SCALAR_TAIL(base, i, n, key);
+#endif
+}
+
+const int64_t *gSearchI64(const int64_t *base, size_t n, int64_t key) {
+#ifdef X86_AVX2
+    if (HAVE_AVX2()) {
+        return searchI64AVX2(base, n, key);
+    }
+#endif
+#ifdef X86_SSE2
+    return searchI64SSE2(base, n, key);
+#else
+    size_t i = 0;
+    SCALAR_TAIL(base, i, n, key);
+#endif
+}
+
+const uint8_t *gSearchU8(const uint8_t *base, size_t n, uint8_t key) {
+    /* The C library already picks a vector memchr for the CPU */
+    if (n == 0) {
+        return NULL;
+    }
+    return (const uint8_t *) memchr(base, key, n);
+}
+
+const float *gSearchF32(const float *base, size_t n, float key) {
+#ifdef X86_AVX2
+    if (HAVE_AVX2()) {
+        return searchF32AVX2(base, n, key);
+    }
+#endif
+#ifdef X86_SSE2
+    return searchF32SSE2(base, n, key);
+#else
+    size_t i = 0;
+    SCALAR_TAIL(base, i, n, key);
+#endif
+}
+
+/* Reverses the order of the elements of size sz packed in a word */
+static inline uint64_t reverseWord(uint64_t x, size_t sz) {
+    switch (sz) {
+    case 1:
+        return __builtin_bswap64(x);
+    case 2:
+        x = __builtin_bswap64(x);
+        return (x >> 8 & 0x00ff00ff00ff00ffull) | (x & 0x00ff00ff00ff00ffull) << 8;
+    case 4:
+        return x >> 32 | x << 32;
+    default:
+        return x;
+    }
+}
+
+#ifdef X86_AVX2
+/*
+ * Reverses 32 byte blocks from both ends while they do not meet, for
+ * elements of 1, 2, 4 or 8 bytes.
+ *
+ * @return  Number of elements reversed at each end
+ */
+AVX2 static size_t reverseBlocksAVX2(char *ptr, size_t n, size_t sz) {
+    char mask[32];
+    size_t per = 32 / sz, done = 0, j;
+    /* Reverses the elements within each 16 byte lane, then the lanes swap */
+    for (j = 0; j < 32; j++) {
+        mask[j] = (char) ((16 / sz - 1 - j % 16 / sz) * sz + j % sz);
+    }
+    const __m256i m = _mm256_loadu_si256((const __m256i *) mask);
+    for (; n - 2 * done >= 2 * per; done += per) {
+        __m256i *lo = (__m256i *) (ptr + done * sz);
+        __m256i *hi = (__m256i *) (ptr + (n - done - per) * sz);
+        __m256i x = _mm256_shuffle_epi8(_mm256_loadu_si256(lo), m);
+        __m256i y = _mm256_shuffle_epi8(_mm256_loadu_si256(hi), m);
+        _mm256_storeu_si256(lo, _mm256_permute4x64_epi64(y, 0x4e));
+        _mm256_storeu_si256(hi, _mm256_permute4x64_epi64(x, 0x4e));
+    }
+    return done;
+}
+#endif
+
 void *gReverse(void *elems, size_t n, size_t elem_sz) {
     char *ptr = (char *) elems;
+    size_t i = 0, j, per;
+    if (n < 2) {
+        return elems;
+    }
+    if (elem_sz == 1 || elem_sz == 2 || elem_sz == 4 || elem_sz == 8) {
+        /* Whole words from both ends, reversed within the word */
+#ifdef X86_AVX2
+        if (HAVE_AVX2() && n * elem_sz >= 64) {
+            i = reverseBlocksAVX2(ptr, n, elem_sz);
+        }
+#endif
+        per = 8 / elem_sz;
+        for (; n - 2 * i >= 2 * per; i += per) {
+            uint64_t x, y;
+            char *lo = ptr + i * elem_sz, *hi = ptr + (n - i - per) * elem_sz;
+            memcpy(&x, lo, 8);
+            memcpy(&y, hi, 8);
+            x = reverseWord(x, elem_sz);
+            y = reverseWord(y, elem_sz);
+            memcpy(lo, &y, 8);
+            memcpy(hi, &x, 8);
+        }
+    }
+    for (j = n - 1 - i; i < j; i++, j--) {
+        swapBytes(ptr + i * elem_sz, ptr + j * elem_sz, elem_sz);
+    }
+    return elems;
+}
+
+/* Rotations whose shorter side fits go through a buffer of this many bytes */
+#define ROTATE_BUFFER 256
+
+void *gRotate(void *elems, size_t n, size_t elem_sz, size_t k) {
+    char *ptr = (char *) elems;
+    unsigned char t[ROTATE_BUFFER];
     size_t i, j;
-    for (i = 0, j = n - 1; i < j; i++) {
-        gSwap(ptr + i * elem_sz, ptr + j * elem_sz, elem_sz);
+    if (k == 0 || k >= n) {
+        return elems;
+    }
+    /*
+     * Gries-Mills: A = [k-i,k) and B = [k,k+j) are left to rotate. While
+     * they differ in length, the shorter one is swapped with the far end
+     * of the longer one, which puts it in its final place. Once the
+     * shorter one fits in the buffer, it is moved across with memmove
+     * instead of many small swaps.
+     */
+    i = k;
+    j = n - k;
+    while (i != j) {
+        char *a = ptr + (k - i) * elem_sz;
+        if (i < j && i * elem_sz <= ROTATE_BUFFER) {
+            memcpy(t, a, i * elem_sz);
+            memmove(a, a + i * elem_sz, j * elem_sz);
+            memcpy(a + j * elem_sz, t, i * elem_sz);
+            return elems;
+        }
+        if (j < i && j * elem_sz <= ROTATE_BUFFER) {
+            memcpy(t, ptr + k * elem_sz, j * elem_sz);
+            memmove(a + j * elem_sz, a, i * elem_sz);
+            memcpy(a, t, j * elem_sz);
+            return elems;
+        }
+        if (i < j) {
+            swapBytes(a, ptr + (k + j - i) * elem_sz, i * elem_sz);
+            j -= i;
+        } else {
+            swapBytes(a, ptr + k * elem_sz, j * elem_sz);
+            i -= j;
+        }
     }
+    swapBytes(ptr + (k - i) * elem_sz, ptr + k * elem_sz, i * elem_sz);
     return elems;
 }
 